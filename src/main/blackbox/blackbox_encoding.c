@@ -266,9 +266,9 @@ int blackboxWriteTag2_3SVariable(int32_t *values)
     int selector = BITS_2;
     int selector2 = 0;
     // Require more than 877 bits?
-    if (values[0] >= 256 || values[0] < -256
-            || values[1] >= 128 || values[1] < -128
-            || values[2] >= 128 || values[2] < -128) {
+    if (values[0] >= 128 || values[0] < -128
+            || values[1] >= 64 || values[1] < -64
+            || values[2] >= 64 || values[2] < -64) {
         selector = BITS_32;
    // Require more than 554 bits?
     } else if (values[0] >= 16 || values[0] < -16
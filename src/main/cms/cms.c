@@ -982,6 +982,8 @@ void cmsUpdate(uint32_t currentTimeUs)
         }
 
         cmsDrawMenu(pCurrentDisplay, currentTimeUs);
+        // buffered display ports only send changed cells on draw
+        displayDrawScreen(pCurrentDisplay);
 
         if (currentTimeMs > lastCmsHeartBeatMs + 500) {
             // Heart beat for external CMS display device @ 500msec
@@ -150,11 +150,14 @@ uint16_t getEEPROMConfigSize(void)
     return eepromConfigSize;
 }
 
-// find config record for reg + classification (profile info) in EEPROM
-// return NULL when record is not found
-// this function assumes that EEPROM content is valid
-static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
+// Initialize all PG records from EEPROM.
+// All PGs are reset to defaults first, then the EEPROM is walked once and each record is loaded into
+//   the PG found by its pgn. pgLoad will handle version mismatch.
+// This function assumes that EEPROM content is valid.
+bool loadEEPROM(void)
 {
+    pgResetAll(PG_PROFILE_COUNT);
+
     const uint8_t *p = &__config_start;
     p += sizeof(configHeader_t);             // skip header
     while (true) {
@@ -163,39 +166,19 @@ static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFla
             || p + record->size >= &__config_end
             || record->size < sizeof(*record))
             break;
-        if (pgN(reg) == record->pgn
-            && (record->flags & CR_CLASSIFICATION_MASK) == classification)
-            return record;
-        p += record->size;
-    }
-    // record not found
-    return NULL;
-}
 
-// Initialize all PG records from EEPROM.
-// This functions processes all PGs sequentially, scanning EEPROM for each one. This is suboptimal,
-//   but each PG is loaded/initialized exactly once and in defined order.
-bool loadEEPROM(void)
-{
-    PG_FOREACH(reg) {
-        configRecordFlags_e cls_start, cls_end;
-        if (pgIsSystem(reg)) {
-            cls_start = CR_CLASSICATION_SYSTEM;
-            cls_end = CR_CLASSICATION_SYSTEM;
-        } else {
-            cls_start = CR_CLASSICATION_PROFILE1;
-            cls_end = CR_CLASSICATION_PROFILE_LAST;
-        }
-        for (configRecordFlags_e cls = cls_start; cls <= cls_end; cls++) {
-            int profileIndex = cls - cls_start;
-            const configRecord_t *rec = findEEPROM(reg, cls);
-            if (rec) {
-                // config from EEPROM is available, use it to initialize PG. pgLoad will handle version mismatch
-                pgLoad(reg, profileIndex, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version);
-            } else {
-                pgReset(reg, profileIndex);
+        const pgRegistry_t *reg = pgFind(record->pgn);
+        const configRecordFlags_e cls = record->flags & CR_CLASSIFICATION_MASK;
+        if (reg) {
+            if (pgIsSystem(reg)) {
+                if (cls == CR_CLASSICATION_SYSTEM) {
+                    pgLoad(reg, 0, record->pg, record->size - offsetof(configRecord_t, pg), record->version);
+                }
+            } else if (cls >= CR_CLASSICATION_PROFILE1 && cls <= CR_CLASSICATION_PROFILE_LAST) {
+                pgLoad(reg, cls - CR_CLASSICATION_PROFILE1, record->pg, record->size - offsetof(configRecord_t, pg), record->version);
             }
         }
+        p += record->size;
     }
     return true;
 }
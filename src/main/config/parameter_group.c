@@ -24,11 +24,56 @@
 #include "parameter_group.h"
 #include "common/maths.h"
 
+// registry entries sorted by pgn, built on the first lookup
+#define PG_INDEX_SIZE 96
+
+static const pgRegistry_t *pgIndex[PG_INDEX_SIZE];
+static uint8_t pgIndexCount;
+static bool pgIndexBuilt = false;
+
+static void pgBuildIndex(void)
+{
+    pgIndexCount = 0;
+    if (PG_REGISTRY_SIZE <= PG_INDEX_SIZE) {
+        PG_FOREACH(reg) {
+            int i = pgIndexCount++;
+            while (i > 0 && pgN(pgIndex[i - 1]) > pgN(reg)) {
+                pgIndex[i] = pgIndex[i - 1];
+                i--;
+            }
+            pgIndex[i] = reg;
+        }
+    }
+    pgIndexBuilt = true;
+}
+
 const pgRegistry_t* pgFind(pgn_t pgn)
 {
-    PG_FOREACH(reg) {
-        if (pgN(reg) == pgn) {
-            return reg;
+    if (!pgIndexBuilt) {
+        pgBuildIndex();
+    }
+
+    if (pgIndexCount != PG_REGISTRY_SIZE) {
+        // registry outgrew the index, scan it
+        PG_FOREACH(reg) {
+            if (pgN(reg) == pgn) {
+                return reg;
+            }
+        }
+        return NULL;
+    }
+
+    int low = 0;
+    int high = pgIndexCount - 1;
+    while (low <= high) {
+        const int mid = (low + high) / 2;
+        const pgn_t midPgn = pgN(pgIndex[mid]);
+        if (midPgn == pgn) {
+            return pgIndex[mid];
+        } else if (midPgn < pgn) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
         }
     }
     return NULL;
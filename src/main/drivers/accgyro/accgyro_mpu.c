@@ -193,6 +193,39 @@ bool mpuAccRead(accDev_t *acc)
     return true;
 }
 
+// Auxiliary I2C master slave data, read out in the same burst as the gyro
+static uint8_t mpuExtSensData[MPU_EXT_SENS_DATA_MAX];
+static uint8_t mpuExtSensLength;
+static volatile bool mpuExtSensRequested;
+static volatile bool mpuExtSensDataNew;
+
+void mpuExtSensDataInit(uint8_t length)
+{
+    mpuExtSensLength = MIN(length, MPU_EXT_SENS_DATA_MAX);
+    mpuExtSensRequested = false;
+    mpuExtSensDataNew = false;
+}
+
+void mpuExtSensDataRequest(void)
+{
+    mpuExtSensRequested = mpuExtSensLength > 0;
+}
+
+bool mpuExtSensDataRead(uint8_t *buf)
+{
+    bool dataNew = false;
+
+    ATOMIC_BLOCK(NVIC_PRIO_MPU_INT_EXTI) {
+        if (mpuExtSensDataNew) {
+            memcpy(buf, mpuExtSensData, mpuExtSensLength);
+            mpuExtSensDataNew = false;
+            dataNew = true;
+        }
+    }
+
+    return dataNew;
+}
+
 void mpuGyroSetIsrUpdate(gyroDev_t *gyro, sensorGyroUpdateFuncPtr updateFn)
 {
     ATOMIC_BLOCK(NVIC_PRIO_MPU_INT_EXTI) {
@@ -202,13 +235,26 @@ void mpuGyroSetIsrUpdate(gyroDev_t *gyro, sensorGyroUpdateFuncPtr updateFn)
 
 bool mpuGyroRead(gyroDev_t *gyro)
 {
-    uint8_t data[6];
+    uint8_t data[6 + MPU_EXT_SENS_DATA_MAX];
+    uint8_t length = 6;
+
+    // EXT_SENS_DATA directly follows the gyro registers, so a pending slave sample costs no extra transaction
+    const bool readExtSens = mpuExtSensRequested && gyro->mpuConfiguration.gyroReadXRegister + 6 == MPU_RA_EXT_SENS_DATA_00;
+    if (readExtSens) {
+        length += mpuExtSensLength;
+    }
 
-    const bool ack = gyro->mpuConfiguration.readFn(&gyro->bus, gyro->mpuConfiguration.gyroReadXRegister, 6, data);
+    const bool ack = gyro->mpuConfiguration.readFn(&gyro->bus, gyro->mpuConfiguration.gyroReadXRegister, length, data);
     if (!ack) {
         return false;
     }
 
+    if (readExtSens) {
+        memcpy(mpuExtSensData, &data[6], mpuExtSensLength);
+        mpuExtSensRequested = false;
+        mpuExtSensDataNew = true;
+    }
+
     gyro->gyroADCRaw[X] = (int16_t)((data[0] << 8) | data[1]);
     gyro->gyroADCRaw[Y] = (int16_t)((data[2] << 8) | data[3]);
     gyro->gyroADCRaw[Z] = (int16_t)((data[4] << 8) | data[5]);
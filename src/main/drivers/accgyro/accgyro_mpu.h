@@ -100,6 +100,7 @@
 #define MPU_RA_GYRO_ZOUT_H      0x47
 #define MPU_RA_GYRO_ZOUT_L      0x48
 #define MPU_RA_EXT_SENS_DATA_00 0x49
+#define MPU_EXT_SENS_DATA_MAX   24
 #define MPU_RA_MOT_DETECT_STATUS    0x61
 #define MPU_RA_I2C_SLV0_DO      0x63
 #define MPU_RA_I2C_SLV1_DO      0x64
@@ -203,4 +204,7 @@ bool mpuGyroRead(struct gyroDev_s *gyro);
 void mpuDetect(struct gyroDev_s *gyro);
 bool mpuCheckDataReady(struct gyroDev_s *gyro);
 void mpuGyroSetIsrUpdate(struct gyroDev_s *gyro, sensorGyroUpdateFuncPtr updateFn);
+void mpuExtSensDataInit(uint8_t length);
+void mpuExtSensDataRequest(void);
+bool mpuExtSensDataRead(uint8_t *buf);
 
@@ -46,7 +46,13 @@ uint8_t adcChannelByTag(ioTag_t ioTag)
 uint16_t adcGetChannel(uint8_t channel)
 {
 #ifdef XMC4500_F100x1024
-	return XMC_VADC_GROUP_GetResult(adcOperatingConfig[channel].group, adcOperatingConfig[channel].adcChannel);
+    // The result register holds a partial sum while the data reduction counter runs,
+    // so only a completed accumulation is taken and the last one is kept otherwise
+    const uint32_t result = XMC_VADC_GROUP_GetDetailedResult(adcOperatingConfig[channel].group, adcOperatingConfig[channel].adcChannel);
+    if ((result & VADC_G_RES_DRC_Msk) == 0) {
+        adcValues[channel] = (result & VADC_G_RES_RESULT_Msk) >> ADC_ACCUMULATION_SHIFT;
+    }
+    return adcValues[channel];
 #else
 #ifdef DEBUG_ADC_CHANNELS
     if (adcOperatingConfig[0].enabled) {
@@ -33,6 +33,9 @@
 #ifdef XMC4500_F100x1024
 #include "dma.h"
 typedef VADC_GLOBAL_TypeDef ADC_TypeDef;
+
+// Background results are accumulated over 1 << ADC_ACCUMULATION_SHIFT conversions by the VADC data reduction
+#define ADC_ACCUMULATION_SHIFT 2
 #endif
 
 typedef enum ADCDevice {
@@ -217,9 +217,10 @@ void adcInit(const adcConfig_t *config)
         };
         XMC_VADC_GROUP_ChannelInit(adcOperatingConfig[i].group, adcOperatingConfig[i].adcChannel, &ch_config);
 
+        // Sum 4 conversions in hardware, the scan runs continuously so the battery tasks only read the result
         XMC_VADC_RESULT_CONFIG_t result_config =
         {
-			.data_reduction_control  = 0,
+			.data_reduction_control  = (1 << ADC_ACCUMULATION_SHIFT) - 1,
 			.post_processing_mode    = XMC_VADC_DMM_REDUCTION_MODE,
 			.wait_for_read_mode  	 = 0,
 			.part_of_fifo       	 = 0,
@@ -299,66 +300,61 @@ void adcInit(const adcConfig_t *config)
 
 #ifdef USE_ONBOARD_ESC
 
+// avg_delay is kept in Q8 so the EMA runs without float math in the ADC interrupt
+#define ESC_DELAY_SHIFT         8
+#define ESC_DELAY_GAIN          13      // ~0.05 in Q8
+#define ESC_DELAY_STARTUP       (300 << ESC_DELAY_SHIFT)
+
+#define ESC_PATTERN_COUNT       6
+#define ESC_PATTERN_OFF         ESC_PATTERN_COUNT
+
+typedef enum {
+    ESC_OUT_OFF = 0,
+    ESC_OUT_PWM_HIGH,
+    ESC_OUT_PWM_LOW,
+    ESC_OUT_ON,
+    ESC_OUT_LEVEL_COUNT
+} escOutLevel_e;
+
+// Output level of each slice per commutation step, the last row is used while the motor is stopped
+static const uint8_t commutationTable[ESC_PATTERN_COUNT + 1][INVERTER_OUT_CNT] = {
+    { ESC_OUT_PWM_HIGH, ESC_OUT_PWM_LOW, ESC_OUT_OFF,      ESC_OUT_OFF,     ESC_OUT_OFF,      ESC_OUT_ON      },
+    { ESC_OUT_PWM_HIGH, ESC_OUT_PWM_LOW, ESC_OUT_OFF,      ESC_OUT_ON,      ESC_OUT_OFF,      ESC_OUT_OFF     },
+    { ESC_OUT_OFF,      ESC_OUT_ON,      ESC_OUT_PWM_HIGH, ESC_OUT_PWM_LOW, ESC_OUT_OFF,      ESC_OUT_OFF     },
+    { ESC_OUT_OFF,      ESC_OUT_OFF,     ESC_OUT_PWM_HIGH, ESC_OUT_PWM_LOW, ESC_OUT_OFF,      ESC_OUT_ON      },
+    { ESC_OUT_OFF,      ESC_OUT_OFF,     ESC_OUT_OFF,      ESC_OUT_ON,      ESC_OUT_PWM_HIGH, ESC_OUT_PWM_LOW },
+    { ESC_OUT_OFF,      ESC_OUT_ON,      ESC_OUT_OFF,      ESC_OUT_OFF,     ESC_OUT_PWM_HIGH, ESC_OUT_PWM_LOW },
+    { ESC_OUT_OFF,      ESC_OUT_OFF,     ESC_OUT_OFF,      ESC_OUT_OFF,     ESC_OUT_OFF,      ESC_OUT_OFF     },
+};
+
+typedef struct {
+    uint8_t phase;      // floating phase sampled for the back-EMF
+    uint8_t rising;     // zero crossing is detected when the phase rises above the reference
+} zeroCrossing_t;
+
+static const zeroCrossing_t zeroCrossingTable[ESC_PATTERN_COUNT] = {
+    { 2, 0 },
+    { 1, 1 },
+    { 0, 0 },
+    { 2, 1 },
+    { 1, 0 },
+    { 0, 1 },
+};
+
+static inline uint8_t commutationStep(uint8_t pattern)
+{
+    return pattern < ESC_PATTERN_COUNT ? pattern : ESC_PATTERN_OFF;
+}
+
 void MotorCommutationCCU8(uint8_t motorIndex)
 {
-	switch (motors[motorIndex].inverter.pattern)
-	{
-		case 0:
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[0], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[1], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[3], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[5], motors[motorIndex].period);
-			break;
-		case 1:
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[0], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[1], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[3], motors[motorIndex].period);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[5], 0);
-			break;
-		case 2:
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[1], motors[motorIndex].period);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[2], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[3], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[5], 0);
-			break;
-		case 3:
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[1], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[2], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[3], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[5], motors[motorIndex].period);
-			break;
-		case 4:
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[1], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[3], motors[motorIndex].period);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[4], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[5], motors[motorIndex].CCR_dummy);
-			break;
-		case 5:
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[1], motors[motorIndex].period);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[3], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[4], motors[motorIndex].CCR_dummy);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[5], motors[motorIndex].CCR_dummy);
-			break;
-		default:
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[1], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[3], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motors[motorIndex].inverter.tim[5], 0);
-			break;
+	pwmOutputPort_t *motor = &motors[motorIndex];
+	const uint8_t *step = commutationTable[commutationStep(motor->inverter.pattern)];
+	const uint16_t compare[ESC_OUT_LEVEL_COUNT] = { 0, motor->CCR_dummy, motor->CCR_dummy, motor->period };
+
+	for (int i = 0; i < INVERTER_OUT_CNT; i += 2) {
+		XMC_CCU8_SLICE_SetTimerCompareMatchChannel1((XMC_CCU8_SLICE_t*)motor->inverter.tim[i], compare[step[i]]);
+		XMC_CCU8_SLICE_SetTimerCompareMatchChannel2((XMC_CCU8_SLICE_t*)motor->inverter.tim[i + 1], compare[step[i + 1]]);
 	}
 
 	XMC_CCU8_EnableShadowTransfer(CCU80, 0xFFFF);
@@ -367,64 +363,13 @@ void MotorCommutationCCU8(uint8_t motorIndex)
 
 void MotorCommutationCCU4(uint8_t motorIndex)
 {
-	switch (motors[motorIndex].inverter.pattern)
-	{
-		case 0:
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[0], motors[motorIndex].CCR_dummy);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[1], motors[motorIndex].CCR_dummy + motors[motorIndex].inverter.deadtime);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[3], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[5], motors[motorIndex].period);
-			break;
-		case 1:
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[0], motors[motorIndex].CCR_dummy);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[1], motors[motorIndex].CCR_dummy + motors[motorIndex].inverter.deadtime);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[3], motors[motorIndex].period);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[5], 0);
-			break;
-		case 2:
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[1], motors[motorIndex].period);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[2], motors[motorIndex].CCR_dummy);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[3], motors[motorIndex].CCR_dummy + motors[motorIndex].inverter.deadtime);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[5], 0);
-			break;
-		case 3:
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[1], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[2], motors[motorIndex].CCR_dummy);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[3], motors[motorIndex].CCR_dummy + motors[motorIndex].inverter.deadtime);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[5], motors[motorIndex].period);
-			break;
-		case 4:
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[1], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[3], motors[motorIndex].period);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[4], motors[motorIndex].CCR_dummy);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[5], motors[motorIndex].CCR_dummy + motors[motorIndex].inverter.deadtime);
-			break;
-		case 5:
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[1], motors[motorIndex].period);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[3], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[4], motors[motorIndex].CCR_dummy);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[5], motors[motorIndex].CCR_dummy + motors[motorIndex].inverter.deadtime);
-			break;
-		default:
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[0], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[1], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[2], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[3], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[4], 0);
-			XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[motorIndex].inverter.tim[5], 0);
-			break;
+	pwmOutputPort_t *motor = &motors[motorIndex];
+	const uint8_t *step = commutationTable[commutationStep(motor->inverter.pattern)];
+	// CCU4 has no dead time generator, the low side is delayed in software
+	const uint16_t compare[ESC_OUT_LEVEL_COUNT] = { 0, motor->CCR_dummy, motor->CCR_dummy + motor->inverter.deadtime, motor->period };
+
+	for (int i = 0; i < INVERTER_OUT_CNT; i++) {
+		XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motor->inverter.tim[i], compare[step[i]]);
 	}
 
 	XMC_CCU4_EnableShadowTransfer(CCU40, 0xFFFF);
@@ -433,98 +378,107 @@ void MotorCommutationCCU4(uint8_t motorIndex)
 	XMC_CCU4_EnableShadowTransfer(CCU43, 0xFFFF);
 }
 
+static bool zeroCrossingDetected(const pwmInverter_t *inverter)
+{
+	if (inverter->pattern >= ESC_PATTERN_COUNT) {
+		return true;
+	}
+
+	// only the floating phase carries the back-EMF, so only that result is read
+	const zeroCrossing_t *zc = &zeroCrossingTable[inverter->pattern];
+	const uint16_t reference = adcGetChannel(0);
+	const uint16_t result = XMC_VADC_GROUP_GetResult(inverter->adc_group, inverter->phase_channel[zc->phase]);
+
+	return zc->rising ? result > reference : result < reference;
+}
+
 void ZerocrossingDetection(uint8_t motorIndex)
 {
-	uint16_t reference = adcGetChannel(0);
+	pwmInverter_t *inverter = &motors[motorIndex].inverter;
 
-	uint16_t result_u = XMC_VADC_GROUP_GetResult(motors[motorIndex].inverter.adc_group, motors[motorIndex].inverter.phase_channel[0]);
-	uint16_t result_v = XMC_VADC_GROUP_GetResult(motors[motorIndex].inverter.adc_group, motors[motorIndex].inverter.phase_channel[1]);
-	uint16_t result_w = XMC_VADC_GROUP_GetResult(motors[motorIndex].inverter.adc_group, motors[motorIndex].inverter.phase_channel[2]);
+	if (inverter->step_cnt < UINT16_MAX)
+		inverter->step_cnt++;
 
-	if (motors[motorIndex].CCR_dummy < motors[motorIndex].inverter.min_ccr)
+	if (motors[motorIndex].CCR_dummy < inverter->min_ccr)
 	{
-		motors[motorIndex].inverter.pattern = 0xff;
-		motors[motorIndex].inverter.avg_delay = 300;
-		motors[motorIndex].inverter.emergency_stop = 0;
-		motors[motorIndex].inverter.emergency_stop_cnt=0;
-		motors[motorIndex].inverter.startup=1;
+		inverter->pattern = 0xff;
+		inverter->step_period = 0;
+		inverter->avg_delay = ESC_DELAY_STARTUP;
+		inverter->emergency_stop = 0;
+		inverter->emergency_stop_cnt=0;
+		inverter->startup=1;
 	}
 	else
 	{
-		if (motors[motorIndex].inverter.disable_cnt > 0)
-			motors[motorIndex].inverter.disable_cnt--;
+		if (inverter->disable_cnt > 0)
+			inverter->disable_cnt--;
 		else
 		{
-			if (motors[motorIndex].inverter.emergency_stop)
+			if (inverter->emergency_stop)
 			{
-				motors[motorIndex].inverter.pattern = 0xff;
+				inverter->pattern = 0xff;
+				inverter->step_period = 0;
 
-				if (calculateThrottleStatus() == THROTTLE_LOW && motors[motorIndex].inverter.emergency_stop_cnt-- == 0)
+				if (calculateThrottleStatus() == THROTTLE_LOW && inverter->emergency_stop_cnt-- == 0)
 				{
-					motors[motorIndex].inverter.avg_delay = 300;
-					motors[motorIndex].inverter.emergency_stop = 0;
-					motors[motorIndex].inverter.startup=1;
+					inverter->avg_delay = ESC_DELAY_STARTUP;
+					inverter->emergency_stop = 0;
+					inverter->startup=1;
 				}
 			}
 			else
 			{
-				motors[motorIndex].inverter.emergency_stop_cnt++;
+				inverter->emergency_stop_cnt++;
 
-				if (motors[motorIndex].inverter.startup && motors[motorIndex].inverter.emergency_stop_cnt > 25000)
+				if (inverter->startup && inverter->emergency_stop_cnt > 25000)
 				{
-					motors[motorIndex].inverter.startup = 0;
-					motors[motorIndex].inverter.emergency_stop_cnt = 0;
+					inverter->startup = 0;
+					inverter->emergency_stop_cnt = 0;
 				}
-				else if(!motors[motorIndex].inverter.startup)
+				else if(!inverter->startup)
 				{
-					if (motors[motorIndex].inverter.emergency_stop_cnt > 100)
-						motors[motorIndex].inverter.emergency_stop = 1;
+					if (inverter->emergency_stop_cnt > 100)
+						inverter->emergency_stop = 1;
 				}
 
-				if (!motors[motorIndex].inverter.crossing_detected)
+				if (!inverter->crossing_detected)
 				{
-					switch (motors[motorIndex].inverter.pattern)
-					{
-						case 0:	if (result_w < reference) motors[motorIndex].inverter.crossing_detected = 1; break;
-						case 1:	if (result_v > reference) motors[motorIndex].inverter.crossing_detected = 1; break;
-						case 2:	if (result_u < reference) motors[motorIndex].inverter.crossing_detected = 1; break;
-						case 3:	if (result_w > reference) motors[motorIndex].inverter.crossing_detected = 1; break;
-						case 4: if (result_v < reference) motors[motorIndex].inverter.crossing_detected = 1; break;
-						case 5:	if (result_u > reference) motors[motorIndex].inverter.crossing_detected = 1; break;
-						default: motors[motorIndex].inverter.crossing_detected = 1;	break;
-					}
+					inverter->crossing_detected = zeroCrossingDetected(inverter);
 
-					if (motors[motorIndex].inverter.pattern != 0xff)
+					if (inverter->pattern != 0xff)
 					{
-						if (motors[motorIndex].inverter.crossing_detected)
-							motors[motorIndex].inverter.avg_delay += (motors[motorIndex].inverter.delay_cnt - motors[motorIndex].inverter.avg_delay)*0.05;
+						if (inverter->crossing_detected)
+							inverter->avg_delay += ((((int32_t)inverter->delay_cnt << ESC_DELAY_SHIFT) - inverter->avg_delay) * ESC_DELAY_GAIN) >> ESC_DELAY_SHIFT;
 						else
-							motors[motorIndex].inverter.delay_cnt++;
+							inverter->delay_cnt++;
 					}
 				}
 				else
 				{
-					if (motors[motorIndex].inverter.pattern == 0xff)
+					if (inverter->pattern == 0xff)
 					{
-						motors[motorIndex].inverter.pattern=0;
-						motors[motorIndex].inverter.disable_cnt = 50000;		//brake before start
+						inverter->pattern=0;
+						inverter->disable_cnt = 50000;		//brake before start
 					}
 					else
 					{
-						if (++motors[motorIndex].inverter.com_cnt > motors[motorIndex].inverter.avg_delay)
+						if (((int32_t)++inverter->com_cnt << ESC_DELAY_SHIFT) > inverter->avg_delay)
 						{
-							motors[motorIndex].inverter.com_cnt = 0;
-							motors[motorIndex].inverter.delay_cnt=0;
-							motors[motorIndex].inverter.crossing_detected=0;
+							inverter->com_cnt = 0;
+							inverter->delay_cnt=0;
+							inverter->crossing_detected=0;
 
-							motors[motorIndex].inverter.pattern++;
-							motors[motorIndex].inverter.disable_cnt = 1;
+							inverter->step_period = inverter->step_cnt;
+							inverter->step_cnt = 0;
 
-							if (motors[motorIndex].inverter.pattern > 5)
-								motors[motorIndex].inverter.pattern = 0;
+							inverter->pattern++;
+							inverter->disable_cnt = 1;
 
-							if (!motors[motorIndex].inverter.startup)
-								motors[motorIndex].inverter.emergency_stop_cnt=0;
+							if (inverter->pattern >= ESC_PATTERN_COUNT)
+								inverter->pattern = 0;
+
+							if (!inverter->startup)
+								inverter->emergency_stop_cnt=0;
 						}
 					}
 				}
@@ -533,6 +487,19 @@ void ZerocrossingDetection(uint8_t motorIndex)
 	}
 }
 
+uint32_t onboardEscGetErpm(uint8_t motorIndex)
+{
+	if (!motors || motorIndex >= getMotorCount())
+		return 0;
+
+	const uint16_t stepPeriod = motors[motorIndex].inverter.step_period;
+	if (!stepPeriod)
+		return 0;
+
+	// one detection per PWM period and six commutation steps per electrical revolution
+	return motorConfig()->dev.motorPwmRate * 60 / (ESC_PATTERN_COUNT * stepPeriod);
+}
+
 void VADC0_G0_0_IRQHandler()
 {
 	ZerocrossingDetection(0);
@@ -50,6 +50,9 @@ typedef struct {
 	// compensation scale factors (data sheet page 15, table 9)
 	uint32_t kP; /**< compensation scale factor for pressure measurement (data sheet page 15, table 9) */
 	uint32_t kT; /**< compensation scale factor for temperature measurement (data sheet page 15, table 9) */
+	// 2^44 / kP and 2^44 / kT, turn a raw value into its scaled Q20 form with one multiply
+	int32_t recipP;
+	int32_t recipT;
 } dps310_calibration_param_t;
 
 typedef struct {
@@ -75,6 +78,7 @@ typedef struct {
 #define DPS310_MEAS_CFG 0x08 ///Sensor Operating mode register
 #define DPS310_CFG_REG 0x09///Interrupt and FIFO-config
 #define DPS310_INT_STS 0x0A///Interrupt status register
+#define DPS310_FIFO_STS 0x0B///FIFO status register
 #define DPS310_RESET_REGISTER 0x0C///reset register of sensor
 #define DPS310_PRODUCT_ID 0x0D ///ID of Sensor
 #define DPS310_COEF_SRC 0x28///Temperature coefficient source
@@ -85,6 +89,16 @@ typedef struct {
 #define DPS310_SOFT_RESET 0x09///sequence to perform soft-reset
 #define DPS310_FIFO_FLUSH 0x80///flush FIFO-Buffer
 
+//interrupt and FIFO-config
+#define DPS310_CFG_T_SHIFT 0x08///temperature result bit-shift, required for oversampling > 8
+#define DPS310_CFG_P_SHIFT 0x04///pressure result bit-shift, required for oversampling > 8
+#define DPS310_CFG_FIFO_EN 0x02///enable FIFO
+
+//FIFO
+#define DPS310_FIFO_SIZE 32///results held by the FIFO, pressure and temperature together
+#define DPS310_FIFO_EMPTY 0x800000///value read from the result registers once the FIFO is empty
+#define DPS310_FIFO_PRESSURE 0x01///LSB of a FIFO result, set for pressure and clear for temperature
+
 //sensor operating mode and status register-config
 #define DPS310_MEAS_CTRL_TEMP_SINGLE 0x02
 #define DPS310_MEAS_CTRL_PRESSURE_SINGLE 0x01
@@ -144,13 +158,21 @@ typedef struct {
 
 #define DPS310_UT_DELAY    5000        // 1.5ms margin according to the spec (4.5ms T conversion time)
 #define DPS310_UP_DELAY    6000       // 6000+21000=27000 1.5ms margin according to the spec (25.5ms P conversion time with OSS=3)
+#define DPS310_FIFO_POLL_DELAY (1000000 / 32) // FIFO drained at 32Hz, two pressure results per poll at 64 results/sec
+
+#define DPS310_SC_SHIFT    20          // scaled raw values are Q20
+#define DPS310_SC_LIMIT    (2 << DPS310_SC_SHIFT) // |scaled value| stays far below 2 between 300 and 1200hPa, the limit keeps the 64bit products in range
 
 STATIC_UNIT_TESTED dps310_t dps310;
-STATIC_UNIT_TESTED uint32_t dps310_ut;  // static result of temperature measurement
+STATIC_UNIT_TESTED int32_t dps310_ut;  // static result of temperature measurement
 STATIC_UNIT_TESTED int32_t dps310_up;  // static result of pressure measurement
 
-float up_sc = 0.0f;
-float ut_sc = 0.0f;
+#ifdef USE_BARO_DPS310_BACKGROUND
+static int32_t dps310_tsc;  // scaled result of the last temperature measurement
+static bool dps310_tsc_valid = false;
+static int32_t dps310_pressure;  // compensated mean of the pressure results read from the FIFO
+static int32_t dps310_temperature;
+#endif
 
 static bool dps310InitDone = false;
 
@@ -160,8 +182,12 @@ static void dps310_start_ut(void);
 static void dps310_get_ut(void);
 static void dps310_start_up(void);
 static void dps310_get_up(void);
-static int32_t dps310_get_temperature(uint32_t ut);
-static int32_t dps310_get_pressure(int32_t up);
+#ifdef USE_BARO_DPS310_BACKGROUND
+static void dps310_read_fifo(void);
+#endif
+STATIC_UNIT_TESTED int32_t dps310_scale(int32_t raw, int32_t recip);
+STATIC_UNIT_TESTED int32_t dps310_get_temperature(int32_t tsc);
+STATIC_UNIT_TESTED int32_t dps310_get_pressure(int32_t psc, int32_t tsc);
 STATIC_UNIT_TESTED void dps310_calculate(int32_t *pressure,
 		int32_t *temperature);
 
@@ -181,8 +207,9 @@ bool dps310Detect(baroDev_t *baro)
 		dps310.chip_id = data;
 
 #ifdef USE_BARO_DPS310_BACKGROUND
-		uint8_t P_config =  DPS310_PM_RATE_128 | DPS310_PM_PRC_2;	// values/sec | oversamplingrate
-		uint8_t T_config =  DPS310_TMP_RATE_32 | DPS310_TMP_PRC_4;	// values/sec | oversampling rate
+		// 64 * 8.4ms + 8 * 3.6ms of conversion per second, temperature only needs to follow slow drift
+		uint8_t P_config =  DPS310_PM_RATE_64 | DPS310_PM_PRC_4;	// values/sec | oversamplingrate
+		uint8_t T_config =  DPS310_TMP_RATE_8 | DPS310_TMP_PRC_1;	// values/sec | oversampling rate
 #else
 		//Add switch case to determine reg value out of oversampling seting
 		uint8_t P_config =  DPS310_PM_PRC_2;	// values/sec | oversamplingrate
@@ -206,22 +233,19 @@ bool dps310Detect(baroDev_t *baro)
 				i2cWrite(BARO_I2C_INSTANCE, DPS310_Address, DPS310_TMP_CFG, T_config);				// use internal sensor (ASIC)
 			}
 
-			if((P_config & 0x0F) > 0x03 && (T_config & 0x0F) > 0x03)
+			uint8_t cfg = 0x00;
+			if ((P_config & 0x0F) > 0x03)
 			{
-				i2cWrite(BARO_I2C_INSTANCE, DPS310_Address, DPS310_CFG_REG, (3<<2) | 0x00); 	//P- and T-Shift
+				cfg |= DPS310_CFG_P_SHIFT;
 			}
-			else if ((P_config & 0x0F) <= 0x03 && (T_config & 0x0F) > 0x03)
+			if ((T_config & 0x0F) > 0x03)
 			{
-				i2cWrite(BARO_I2C_INSTANCE, DPS310_Address, DPS310_CFG_REG, (2<<2) | 0x00); 	//T-Shift
-			}
-			else if ((P_config & 0x0F) > 0x03 && (T_config & 0x0F) <= 0x03)
-			{
-				i2cWrite(BARO_I2C_INSTANCE, DPS310_Address, DPS310_CFG_REG, (1<<2) | 0x00); 	//P-Shift
-			}
-			else
-			{
-				i2cWrite(BARO_I2C_INSTANCE, DPS310_Address, DPS310_CFG_REG, 0x00); 			//no shift
+				cfg |= DPS310_CFG_T_SHIFT;
 			}
+#ifdef USE_BARO_DPS310_BACKGROUND
+			cfg |= DPS310_CFG_FIFO_EN;
+#endif
+			i2cWrite(BARO_I2C_INSTANCE, DPS310_Address, DPS310_CFG_REG, cfg);
 
 			dps310_get_cal_param(); /* readout DPS310 calibparam structure */
 			baro->ut_delay = DPS310_UT_DELAY;
@@ -232,6 +256,12 @@ bool dps310Detect(baroDev_t *baro)
 			baro->get_up = dps310_get_up;
 			baro->calculate = dps310_calculate;
 
+#ifdef USE_BARO_DPS310_BACKGROUND
+			// the sensor measures on its own, each poll drains whatever has queued up in the FIFO
+			baro->up_delay = DPS310_FIFO_POLL_DELAY;
+			baro->get_up = dps310_read_fifo;
+#endif
+
 			dps310InitDone = true;
 
 #ifdef USE_BARO_DPS310_BACKGROUND
@@ -246,6 +276,17 @@ bool dps310Detect(baroDev_t *baro)
 
 
 
+/* 24bit two's complement value out of three result registers */
+static int32_t dps310_raw_value(const uint8_t *data)
+{
+	int32_t raw = (int32_t) (data[0] << 16 | data[1] << 8 | data[2]);
+	if (raw > 8388607)	// convert to signed int (raw > (pow(2, 23) - 1))
+	{
+		raw = raw - 16777216;	/*raw - pow(2, 24)*/
+	}
+	return raw;
+}
+
 static void dps310_start_ut(void) {
 
 	i2cWrite(BARO_I2C_INSTANCE, DPS310_Address, DPS310_MEAS_CFG, DPS310_MEAS_CTRL_TEMP_SINGLE);
@@ -254,7 +295,6 @@ static void dps310_start_ut(void) {
 static void dps310_get_ut(void) {
 
 	uint8_t data[3];
-	uint32_t ut_temp = 0U;
 	uint8_t x08;
 
 	i2cRead(BARO_I2C_INSTANCE, DPS310_Address, DPS310_MEAS_CFG, 1, &x08);
@@ -265,14 +305,7 @@ static void dps310_get_ut(void) {
 	if (temp_ready)
 	{
 		i2cRead(BARO_I2C_INSTANCE, DPS310_Address, DPS310_TMP_B2, 3, data);
-		ut_temp = (uint32_t) (data[0] << 16 | data[1] << 8 | data[2]);
-		/* generate ut
-		 24bit two's complement value out of reg 3-5*/
-		if (ut_temp > 8388607u)	// convert to signed int (ut > (ut(2, 23) - 1))
-		{
-			ut_temp = ut_temp - 16777216u; /*ut - pow(2, 24)*/
-		}
-		dps310_ut = ut_temp;
+		dps310_ut = dps310_raw_value(data);
 	}
 }
 
@@ -284,7 +317,6 @@ static void dps310_start_up(void) {
 static void dps310_get_up(void) {
 
 	uint8_t data[3];
-	int32_t up_temp = 0U;
 	uint8_t x08;
 	i2cRead(BARO_I2C_INSTANCE, DPS310_Address, DPS310_MEAS_CFG, 1, &x08);
 
@@ -293,65 +325,106 @@ static void dps310_get_up(void) {
 	if (pressure_ready)
 	{
 		i2cRead(BARO_I2C_INSTANCE, DPS310_Address, DPS310_PSR_B2, 3, data);
+		dps310_up = dps310_raw_value(data);
+	}
+}
+
+#ifdef USE_BARO_DPS310_BACKGROUND
+/*
+ * Every read of the pressure result registers pops the oldest FIFO entry, an empty FIFO reads as DPS310_FIFO_EMPTY.
+ * Results are compensated as they come out, pressure with the temperature that preceded it, and the
+ * pressures of one poll are averaged.
+ */
+static void dps310_read_fifo(void)
+{
+	int32_t pressureSum = 0;
+	int pressureCount = 0;
+
+	for (int i = 0; i < DPS310_FIFO_SIZE; i++)
+	{
+		uint8_t data[3];
+		if (!i2cRead(BARO_I2C_INSTANCE, DPS310_Address, DPS310_PSR_B2, 3, data))
+		{
+			break;
+		}
 
-		up_temp = (int32_t) (data[0] << 16 | data[1] << 8 | data[2]);
-		/* generate Praw */
-		if (up_temp > 8388607u)	/*convert to signed int (Praw > (pow(2, 23) - 1))*/
+		const int32_t raw = dps310_raw_value(data);
+		if (raw == -DPS310_FIFO_EMPTY)	// 0x800000 as a signed 24bit value
+		{
+			break;
+		}
+
+		if (raw & DPS310_FIFO_PRESSURE)
+		{
+			// pressure can't be compensated before the first temperature result
+			if (dps310_tsc_valid)
+			{
+				pressureSum += dps310_get_pressure(dps310_scale(raw, dps310.cal_param.recipP), dps310_tsc);
+				pressureCount++;
+			}
+		}
+		else
 		{
-			up_temp = up_temp - 16777216u;  /*Praw - pow(2, 24)*/
+			dps310_tsc = dps310_scale(raw, dps310.cal_param.recipT);
+			dps310_tsc_valid = true;
+			dps310_temperature = dps310_get_temperature(dps310_tsc);
 		}
-		dps310_up = up_temp;
+	}
+
+	if (pressureCount > 0)
+	{
+		dps310_pressure = (pressureSum + pressureCount / 2) / pressureCount;
 	}
 }
+#endif
 
 STATIC_UNIT_TESTED void dps310_calculate(int32_t *pressure,int32_t *temperature)
 {
 	int32_t temp, press;
 
-	temp = dps310_get_temperature(dps310_ut);
-	press = dps310_get_pressure(dps310_up);
+#ifdef USE_BARO_DPS310_BACKGROUND
+	temp = dps310_temperature;
+	press = dps310_pressure;
+#else
+	const int32_t tsc = dps310_scale(dps310_ut, dps310.cal_param.recipT);
+	temp = dps310_get_temperature(tsc);
+	press = dps310_get_pressure(dps310_scale(dps310_up, dps310.cal_param.recipP), tsc);
+#endif
 	if (pressure)
 		*pressure = press;
 	if (temperature)
 		*temperature = temp;
 }
 
-static int32_t dps310_get_temperature(uint32_t ut) {
-
-	int32_t temperature;
-
-	// calculate physical temperature Tcomp [°C]
-	ut_sc = (float) ut / dps310.cal_param.kT;
-	temperature = (int32_t)(dps310.cal_param.c0 * 0.5 + dps310.cal_param.c1 * ut_sc) ;
-
-	return temperature;
+// scaled raw value Traw_sc or Praw_sc (data sheet page 13) in Q20
+STATIC_UNIT_TESTED int32_t dps310_scale(int32_t raw, int32_t recip)
+{
+	const int32_t sc = ((int64_t)raw * recip) >> 24;
+	return sc > DPS310_SC_LIMIT ? DPS310_SC_LIMIT : sc < -DPS310_SC_LIMIT ? -DPS310_SC_LIMIT : sc;
 }
 
-static int32_t dps310_get_pressure(int32_t up) {
-
-	float pressure;
-	float T_raw_sc;
-	float P_raw_sc;
+// Tcomp = c0 * 0.5 + c1 * Traw_sc, in 0.01 degC
+STATIC_UNIT_TESTED int32_t dps310_get_temperature(int32_t tsc) {
 
-	float offset = 0.0f;
-	float firstTerm = 0.0f;
-	float secondTerm = 0.0f;
-	float thirdTerm = 0.0f;
+	const int64_t temperature = (int64_t)dps310.cal_param.c1 * tsc * 100;
+	return dps310.cal_param.c0 * 50 + (int32_t)((temperature + (1 << (DPS310_SC_SHIFT - 1))) >> DPS310_SC_SHIFT);
+}
 
-	// calculate physical pressure Pcomp [Pa]
-	up_sc = (float) up / dps310.cal_param.kP;
+// Pcomp = c00 + Praw_sc * (c10 + Praw_sc * (c20 + Praw_sc * c30)) + Traw_sc * c01 + Traw_sc * Praw_sc * (c11 + Praw_sc * c21), in Pa
+STATIC_UNIT_TESTED int32_t dps310_get_pressure(int32_t psc, int32_t tsc) {
 
-	T_raw_sc = ut_sc;
-	P_raw_sc = up_sc;
+	const dps310_calibration_param_t *cal = &dps310.cal_param;
 
-	offset = dps310.cal_param.c00;
-	firstTerm  = P_raw_sc * ( (float) dps310.cal_param.c10 + P_raw_sc * ( (float)dps310.cal_param.c20 + P_raw_sc * (float) dps310.cal_param.c30));
-	secondTerm = T_raw_sc * (float) dps310.cal_param.c01;
-	thirdTerm  = T_raw_sc * P_raw_sc * ( (float) dps310.cal_param.c11 + P_raw_sc * (float) dps310.cal_param.c21);
+	// all terms in Q20, with |psc| and |tsc| below 2 the products stay under 2^62
+	int64_t pressure = (int64_t)cal->c20 * (1 << DPS310_SC_SHIFT) + (int64_t)cal->c30 * psc;
+	pressure = (int64_t)cal->c10 * (1 << DPS310_SC_SHIFT) + ((pressure * psc) >> DPS310_SC_SHIFT);
+	pressure = (int64_t)cal->c00 * (1 << DPS310_SC_SHIFT) + ((pressure * psc) >> DPS310_SC_SHIFT);
 
-	pressure = offset + firstTerm + secondTerm + thirdTerm;
+	int64_t cross = (int64_t)cal->c11 * (1 << DPS310_SC_SHIFT) + (int64_t)cal->c21 * psc;
+	cross = (cross * psc) >> DPS310_SC_SHIFT;
+	pressure += (int64_t)cal->c01 * tsc + ((cross * tsc) >> DPS310_SC_SHIFT);
 
-	return (int32_t)pressure;
+	return (int32_t)((pressure + (1 << (DPS310_SC_SHIFT - 1))) >> DPS310_SC_SHIFT);
 }
 
 static void dps310_get_cal_param(void) {
@@ -474,6 +547,8 @@ static void dps310_get_cal_param(void) {
 		break;
 	}
 
+	dps310.cal_param.recipP = ((1ULL << 44) + dps310.cal_param.kP / 2) / dps310.cal_param.kP;
+	dps310.cal_param.recipT = ((1ULL << 44) + dps310.cal_param.kT / 2) / dps310.cal_param.kT;
 }
 
 #endif /* BARO */
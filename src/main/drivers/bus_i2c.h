@@ -59,3 +59,5 @@ bool i2cWrite(I2CDevice device, uint8_t addr_, uint8_t reg, uint8_t data);
 bool i2cRead(I2CDevice device, uint8_t addr_, uint8_t reg, uint8_t len, uint8_t* buf);
 
 uint16_t i2cGetErrorCounter(void);
+uint32_t i2cGetTransactionCounter(void);
+uint32_t i2cGetByteCounter(void);
@@ -42,6 +42,8 @@
 static uint32_t i2cTimeout;
 
 static volatile uint16_t i2cErrorCount = 0;
+static volatile uint32_t i2cTransactionCount = 0;
+static volatile uint32_t i2cByteCount = 0;
 
 const i2cHardware_t i2cHardware[I2CDEV_COUNT] = {
 #ifdef USE_I2C_DEVICE_1
@@ -136,6 +138,16 @@ uint16_t i2cGetErrorCounter(void)
     return i2cErrorCount;
 }
 
+uint32_t i2cGetTransactionCounter(void)
+{
+    return i2cTransactionCount;
+}
+
+uint32_t i2cGetByteCounter(void)
+{
+    return i2cByteCount;
+}
+
 bool i2cWrite(I2CDevice device, uint8_t addr_, uint8_t reg, uint8_t data)
 {
     if (device == I2CINVALID || device > I2CDEV_COUNT) {
@@ -169,6 +181,9 @@ bool i2cWrite(I2CDevice device, uint8_t addr_, uint8_t reg, uint8_t data)
     		return i2cTimeoutUserCallback();
     }
 
+    i2cTransactionCount++;
+    i2cByteCount += 3;  // address, register, data
+
     return true;
 }
 
@@ -243,6 +258,9 @@ bool i2cRead(I2CDevice device, uint8_t addr_, uint8_t reg, uint8_t len, uint8_t*
 			return i2cTimeoutUserCallback();
     }
 
+    i2cTransactionCount++;
+    i2cByteCount += 3 + len;  // address, register, address again, data
+
     /* If all operations OK */
     return true;
 }
@@ -17,6 +17,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <math.h>
 
@@ -179,6 +180,13 @@ static bool ak8963SensorCompleteRead(uint8_t *buf)
     return true;
 }
 #else
+// STATUS1, the 6 data bytes and STATUS2, which has to be read to release the next sample
+#define AK8963_EXT_SENS_DATA_LENGTH     8
+#define MPU_I2C_SLV_READ_EN             0x80
+#define MPU_I2C_MST_DELAY_SLV0          0x01
+#define MPU_I2C_MST_DELAY               7       // slave polled every 8th sample
+#define MPU_USER_CTRL_I2C_MST_EN        0x20
+
 static bool ak8963SensorRead(uint8_t addr_, uint8_t reg_, uint8_t len, uint8_t* buf)
 {
     return i2cRead(MAG_I2C_INSTANCE, addr_, reg_, len, buf);
@@ -188,6 +196,25 @@ static bool ak8963SensorWrite(uint8_t addr_, uint8_t reg_, uint8_t data)
 {
     return i2cWrite(MAG_I2C_INSTANCE, addr_, reg_, data);
 }
+
+// Leave bypass mode and let the MPU auxiliary master poll the AK8963 into EXT_SENS_DATA,
+// from where the gyro read picks it up without a transaction of its own
+static void ak8963AuxMasterInit(void)
+{
+    mpuWriteRegisterI2C(bus, MPU_RA_INT_PIN_CFG, MPU6500_BIT_INT_ANYRD_2CLEAR);
+    delay(10);
+    mpuWriteRegisterI2C(bus, MPU_RA_I2C_MST_CTRL, 0x0D);                                  // I2C multi-master / 400kHz
+    mpuWriteRegisterI2C(bus, MPU_RA_I2C_SLV0_ADDR, AK8963_MAG_I2C_ADDRESS | READ_FLAG);
+    mpuWriteRegisterI2C(bus, MPU_RA_I2C_SLV0_REG, AK8963_MAG_REG_STATUS1);
+    mpuWriteRegisterI2C(bus, MPU_RA_I2C_SLV0_CTRL, MPU_I2C_SLV_READ_EN | AK8963_EXT_SENS_DATA_LENGTH);
+    mpuWriteRegisterI2C(bus, MPU_RA_I2C_SLV4_CTRL, MPU_I2C_MST_DELAY);
+    mpuWriteRegisterI2C(bus, MPU_RA_I2C_MST_DELAY_CTRL, MPU_I2C_MST_DELAY_SLV0);
+    mpuWriteRegisterI2C(bus, MPU_RA_USER_CTRL, MPU_USER_CTRL_I2C_MST_EN);
+    delay(10);
+
+    mpuExtSensDataInit(AK8963_EXT_SENS_DATA_LENGTH);
+    mpuExtSensDataRequest();
+}
 #endif
 
 static bool ak8963Init()
@@ -219,7 +246,10 @@ static bool ak8963Init()
 #if defined(USE_SPI) && defined(MPU9250_SPI_INSTANCE)
     ak8963SensorWrite(AK8963_MAG_I2C_ADDRESS, AK8963_MAG_REG_CNTL, CNTL_MODE_CONT1);
 #else
-    ak8963SensorWrite(AK8963_MAG_I2C_ADDRESS, AK8963_MAG_REG_CNTL, CNTL_MODE_ONCE);
+    ak8963SensorWrite(AK8963_MAG_I2C_ADDRESS, AK8963_MAG_REG_CNTL, CNTL_MODE_CONT2);
+    delay(10);
+
+    ak8963AuxMasterInit();
 #endif
     return true;
 }
@@ -284,15 +314,18 @@ restart:
         }
     }
 #else
-    ack = ak8963SensorRead(AK8963_MAG_I2C_ADDRESS, AK8963_MAG_REG_STATUS1, 1, &buf[0]);
+    uint8_t extSensData[AK8963_EXT_SENS_DATA_LENGTH];
+
+    ack = mpuExtSensDataRead(extSensData);
 
-    uint8_t status = buf[0];
+    // have the next gyro read bring along a fresh sample
+    mpuExtSensDataRequest();
 
-    if (!ack || (status & STATUS1_DATA_READY) == 0) {
+    if (!ack || (extSensData[0] & STATUS1_DATA_READY) == 0) {
         return false;
     }
 
-    ack = ak8963SensorRead(AK8963_MAG_I2C_ADDRESS, AK8963_MAG_REG_HXL, 7, &buf[0]);
+    memcpy(buf, &extSensData[1], sizeof(buf));
 #endif
     uint8_t status2 = buf[6];
     if (!ack || (status2 & STATUS2_DATA_ERROR) || (status2 & STATUS2_MAG_SENSOR_OVERFLOW)) {
@@ -305,10 +338,8 @@ restart:
 
 #if defined(USE_SPI) && defined(MPU9250_SPI_INSTANCE)
     state = CHECK_STATUS;
-    return true;
-#else
-    return ak8963SensorWrite(AK8963_MAG_I2C_ADDRESS, AK8963_MAG_REG_CNTL, CNTL_MODE_ONCE); // start reading again
 #endif
+    return true;
 }
 
 bool ak8963Detect(magDev_t *mag)
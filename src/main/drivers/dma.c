@@ -82,6 +82,31 @@ DEFINE_DMA_IRQ_HANDLER(2, 1, DMA1_CH8_HANDLER)
 DEFINE_DMA_IRQ_HANDLER(2, 2, DMA1_CH8_HANDLER)
 DEFINE_DMA_IRQ_HANDLER(2, 3, DMA1_CH8_HANDLER)
 DEFINE_DMA_IRQ_HANDLER(2, 4, DMA1_CH8_HANDLER)
+
+// All channels of a GPDMA module share one interrupt, hand it to the channels with pending events.
+// The channel handler has to clear its events.
+static void dmaModuleIRQHandler(XMC_DMA_t *dma, dmaIdentifier_e first, uint8_t channelCount)
+{
+    const uint32_t pending = XMC_DMA_GetChannelsTransferCompleteStatus(dma) |
+                             XMC_DMA_GetChannelsBlockCompleteStatus(dma) |
+                             XMC_DMA_GetChannelsErrorStatus(dma);
+
+    for (int i = 0; i < channelCount; i++) {
+        if ((pending & (1 << i)) && dmaDescriptors[first + i].irqHandlerCallback) {
+            dmaDescriptors[first + i].irqHandlerCallback(&dmaDescriptors[first + i]);
+        }
+    }
+}
+
+void GPDMA0_0_IRQHandler(void)
+{
+    dmaModuleIRQHandler(XMC_DMA0, DMA1_CH1_HANDLER, XMC_DMA0_NUM_CHANNELS);
+}
+
+void GPDMA1_0_IRQHandler(void)
+{
+    dmaModuleIRQHandler(XMC_DMA1, DMA2_CH1_HANDLER, XMC_DMA1_NUM_CHANNELS);
+}
 #endif
 
 void dmaInit(dmaIdentifier_e identifier, resourceOwner_e owner, uint8_t resourceIndex)
@@ -29,13 +29,28 @@
 #include "drivers/pwm_output.h"
 
 #define MULTISHOT_5US_PW    (MULTISHOT_TIMER_MHZ * 5)
-#define MULTISHOT_20US_MULT (MULTISHOT_TIMER_MHZ * 20 / 1000.0f)
+
+#define MOTOR_SCALE_SHIFT   16
 
 #define DSHOT_MAX_COMMAND 47
 
 static pwmWriteFuncPtr pwmWritePtr;
 static pwmOutputPort_t motors[MAX_SUPPORTED_MOTORS];
 static pwmCompleteWriteFuncPtr pwmCompleteWritePtr = NULL;
+static uint32_t motorScale;
+static uint32_t motorOffset;
+
+#if defined(XMC4500_F100x1024) && !defined(USE_ONBOARD_ESC)
+#define CCU4_MODULE_COUNT 4
+
+typedef struct {
+    XMC_CCU4_MODULE_t *module;
+    uint32_t mask;
+} pwmShadowTransfer_t;
+
+static pwmShadowTransfer_t motorShadowTransfer[CCU4_MODULE_COUNT];
+static uint8_t motorShadowTransferCount;
+#endif
 
 #ifdef USE_SERVOS
 static pwmOutputPort_t servos[MAX_SUPPORTED_SERVOS];
@@ -47,6 +62,9 @@ static uint16_t freqBeep=0;
 #endif
 
 bool pwmMotorsEnabled = false;
+#ifdef USE_ONBOARD_ESC
+static bool onboardEscActive = false;
+#endif
 
 static void pwmOCConfig(TIM_TypeDef *tim, uint8_t channel, uint16_t value, uint8_t output)
 {
@@ -216,6 +234,50 @@ static void pwmOutConfig(pwmOutputPort_t *port, int outIndex, const timerHardwar
     *port->ccr = 0;
 }
 #else
+#ifdef XMC4500_F100x1024
+static uint8_t pwmCCU4SliceIndex(const TIM_TypeDef *tim)
+{
+    switch ((int)tim)
+    {
+    	case (int)CCU40_CC41:
+    	case (int)CCU41_CC41:
+    	case (int)CCU42_CC41:
+    	case (int)CCU43_CC41:
+    		return 1;
+    	case (int)CCU40_CC42:
+    	case (int)CCU41_CC42:
+    	case (int)CCU42_CC42:
+    	case (int)CCU43_CC42:
+    		return 2;
+    	case (int)CCU40_CC43:
+    	case (int)CCU41_CC43:
+    	case (int)CCU42_CC43:
+    	case (int)CCU43_CC43:
+    		return 3;
+    	default:
+    		return 0;
+    }
+}
+
+// Adds a motor slice to the shadow transfer of its CCU4 module, so all motors latch with one transfer per module
+static void pwmAddMotorShadowTransfer(const timerHardware_t *timerHardware)
+{
+    XMC_CCU4_MODULE_t *module = (XMC_CCU4_MODULE_t*)timerHardware->ccu_global;
+    const uint32_t mask = (uint32_t)XMC_CCU4_SHADOW_TRANSFER_SLICE_0 << (4 * pwmCCU4SliceIndex(timerHardware->tim));
+
+    for (int i = 0; i < motorShadowTransferCount; i++) {
+        if (motorShadowTransfer[i].module == module) {
+            motorShadowTransfer[i].mask |= mask;
+            return;
+        }
+    }
+
+    motorShadowTransfer[motorShadowTransferCount].module = module;
+    motorShadowTransfer[motorShadowTransferCount].mask = mask;
+    motorShadowTransferCount++;
+}
+#endif
+
 static void pwmOutConfig(pwmOutputPort_t *port, const timerHardware_t *timerHardware, uint8_t mhz, uint16_t period, uint16_t value, uint8_t inversion)
 {
 #if defined(USE_HAL_DRIVER)
@@ -234,38 +296,7 @@ static void pwmOutConfig(pwmOutputPort_t *port, const timerHardware_t *timerHard
         HAL_TIM_PWM_Start(Handle, timerHardware->channel);
     HAL_TIM_Base_Start(Handle);
 #elif defined(XMC4500_F100x1024)
-    uint8_t channel;
-    switch ((int)timerHardware->tim)
-    {
-    	case (int)CCU40_CC40:
-    	case (int)CCU41_CC40:
-    	case (int)CCU42_CC40:
-    	case (int)CCU43_CC40:
-    		channel = 0;
-    		break;
-    	case (int)CCU40_CC41:
-    	case (int)CCU41_CC41:
-    	case (int)CCU42_CC41:
-    	case (int)CCU43_CC41:
-    		channel = 1;
-    		break;
-    	case (int)CCU40_CC42:
-    	case (int)CCU41_CC42:
-    	case (int)CCU42_CC42:
-    	case (int)CCU43_CC42:
-    		channel = 2;
-    		break;
-    	case (int)CCU40_CC43:
-    	case (int)CCU41_CC43:
-    	case (int)CCU42_CC43:
-    	case (int)CCU43_CC43:
-    		channel = 3;
-    		break;
-    	default:
-    		channel = 0;
-    		break;
-    }
-    XMC_CCU4_EnableClock((XMC_CCU4_MODULE_t*)timerHardware->ccu_global, channel);
+    XMC_CCU4_EnableClock((XMC_CCU4_MODULE_t*)timerHardware->ccu_global, pwmCCU4SliceIndex(timerHardware->tim));
     XMC_CCU4_SLICE_StartTimer((XMC_CCU4_SLICE_t*)timerHardware->tim);
 #else
     TIM_CtrlPWMOutputs(timerHardware->tim, ENABLE);
@@ -302,28 +333,16 @@ static void pwmWriteBrushed(uint8_t index, uint16_t value)
 }
 #endif
 
-static void pwmWriteStandard(uint8_t index, uint16_t value)
-{
-#ifdef XMC4500_F100x1024
-    *motors[index].ccr = lrintf((float)(value * PWM_TIMER_MHZ/1.0f));;
-#else
-    *motors[index].ccr = value;
-#endif
-}
-
-static void pwmWriteOneShot125(uint8_t index, uint16_t value)
+// Analog protocols map the motor value to timer ticks as (value * scale + offset) >> MOTOR_SCALE_SHIFT
+static void pwmWriteScaled(uint8_t index, uint16_t value)
 {
-    *motors[index].ccr = lrintf((float)(value * ONESHOT125_TIMER_MHZ/8.0f));
+    *motors[index].ccr = (value * motorScale + motorOffset) >> MOTOR_SCALE_SHIFT;
 }
 
-static void pwmWriteOneShot42(uint8_t index, uint16_t value)
+static void pwmSetMotorScale(uint32_t tickNumerator, uint32_t usDenominator, uint16_t valueOffset, uint32_t tickOffset)
 {
-    *motors[index].ccr = lrintf((float)(value * ONESHOT42_TIMER_MHZ/24.0f));
-}
-
-static void pwmWriteMultiShot(uint8_t index, uint16_t value)
-{
-    *motors[index].ccr = lrintf(((float)(value-1000) * MULTISHOT_20US_MULT) + MULTISHOT_5US_PW);
+    motorScale = (tickNumerator << MOTOR_SCALE_SHIFT) / usDenominator;
+    motorOffset = (tickOffset << MOTOR_SCALE_SHIFT) - valueOffset * motorScale + (1 << (MOTOR_SCALE_SHIFT - 1));
 }
 
 void pwmWriteMotor(uint8_t index, uint16_t value)
@@ -367,41 +386,15 @@ static void pwmCompleteWriteUnused(uint8_t motorCount)
 static void pwmCompleteWriteXMC(uint8_t motorCount)
 {
 #ifndef USE_ONBOARD_ESC
-	XMC_CCU4_MODULE_t* module = NULL;
-
-	for (int index = 0; index < motorCount; index++)
-	{
-		switch ((uint32_t)motors[index].tim)
-		{
-			case (uint32_t)CCU40_CC40:
-			case (uint32_t)CCU40_CC41:
-			case (uint32_t)CCU40_CC42:
-			case (uint32_t)CCU40_CC43:
-				module = CCU40;
-				break;
-			case (uint32_t)CCU41_CC40:
-			case (uint32_t)CCU41_CC41:
-			case (uint32_t)CCU41_CC42:
-			case (uint32_t)CCU41_CC43:
-				module = CCU41;
-				break;
-			case (uint32_t)CCU42_CC40:
-			case (uint32_t)CCU42_CC41:
-			case (uint32_t)CCU42_CC42:
-			case (uint32_t)CCU42_CC43:
-				module = CCU42;
-				break;
-			case (uint32_t)CCU43_CC40:
-			case (uint32_t)CCU43_CC41:
-			case (uint32_t)CCU43_CC42:
-			case (uint32_t)CCU43_CC43:
-				module = CCU43;
-				break;
-		}
-
+	for (int index = 0; index < motorCount; index++) {
 		XMC_CCU4_SLICE_SetTimerCompareMatch((XMC_CCU4_SLICE_t*)motors[index].tim, motors[index].CCR_dummy);
-		XMC_CCU4_EnableShadowTransfer(module, 0x1111);
 	}
+
+	for (int i = 0; i < motorShadowTransferCount; i++) {
+		XMC_CCU4_EnableShadowTransfer(motorShadowTransfer[i].module, motorShadowTransfer[i].mask);
+	}
+#else
+	UNUSED(motorCount);
 #endif
 }
 #endif
@@ -434,6 +427,9 @@ void pwmCompleteMotorUpdate(uint8_t motorCount)
 void motorDevInit(const motorDevConfig_t *motorConfig, uint16_t idlePulse, uint8_t motorCount)
 {
      memset(motors, 0, sizeof(motors));
+#if defined(XMC4500_F100x1024) && !defined(USE_ONBOARD_ESC)
+    motorShadowTransferCount = 0;
+#endif
 
     uint32_t timerMhzCounter = 0;
     bool useUnsyncedPwm = motorConfig->useUnsyncedPwm;
@@ -443,15 +439,18 @@ void motorDevInit(const motorDevConfig_t *motorConfig, uint16_t idlePulse, uint8
     default:
     case PWM_TYPE_ONESHOT125:
         timerMhzCounter = ONESHOT125_TIMER_MHZ;
-        pwmWritePtr = pwmWriteOneShot125;
+        pwmWritePtr = pwmWriteScaled;
+        pwmSetMotorScale(ONESHOT125_TIMER_MHZ, 8, 0, 0);
         break;
     case PWM_TYPE_ONESHOT42:
         timerMhzCounter = ONESHOT42_TIMER_MHZ;
-        pwmWritePtr = pwmWriteOneShot42;
+        pwmWritePtr = pwmWriteScaled;
+        pwmSetMotorScale(ONESHOT42_TIMER_MHZ, 24, 0, 0);
         break;
     case PWM_TYPE_MULTISHOT:
         timerMhzCounter = MULTISHOT_TIMER_MHZ;
-        pwmWritePtr = pwmWriteMultiShot;
+        pwmWritePtr = pwmWriteScaled;
+        pwmSetMotorScale(MULTISHOT_TIMER_MHZ * 20, 1000, 1000, MULTISHOT_5US_PW);
         break;
 #ifdef USE_ONBOARD_ESC
     case PWM_TYPE_ONBOARD_ESC:
@@ -459,6 +458,7 @@ void motorDevInit(const motorDevConfig_t *motorConfig, uint16_t idlePulse, uint8
     	pwmWritePtr = pwmWriteOnboardESC;
     	pwmCompleteWritePtr = pwmCompleteWriteUnused;
     	isDigital = true;
+    	onboardEscActive = true;
     	break;
 #else
     case PWM_TYPE_BRUSHED:
@@ -470,7 +470,8 @@ void motorDevInit(const motorDevConfig_t *motorConfig, uint16_t idlePulse, uint8
 #endif
     case PWM_TYPE_STANDARD:
         timerMhzCounter = PWM_TIMER_MHZ;
-        pwmWritePtr = pwmWriteStandard;
+        pwmWritePtr = pwmWriteScaled;
+        pwmSetMotorScale(PWM_TIMER_MHZ, 1, 0, 0);
         useUnsyncedPwm = true;
         idlePulse = 0;
         break;
@@ -479,6 +480,9 @@ void motorDevInit(const motorDevConfig_t *motorConfig, uint16_t idlePulse, uint8
     case PWM_TYPE_DSHOT600:
     case PWM_TYPE_DSHOT300:
     case PWM_TYPE_DSHOT150:
+#ifdef USE_DSHOT_TELEMETRY
+        useDshotTelemetry = motorConfig->useDshotTelemetry;
+#endif
         pwmWritePtr = pwmWriteDigital;
         pwmCompleteWritePtr = pwmCompleteDigitalMotorUpdate;
         isDigital = true;
@@ -571,6 +575,13 @@ void motorDevInit(const motorDevConfig_t *motorConfig, uint16_t idlePulse, uint8
 
 #ifdef USE_DSHOT
         if (isDigital) {
+#ifdef XMC4500_F100x1024
+            // the slice runs as plain PWM with the bit period, the compare values of the frame are fed by DMA
+            IOInit(motors[motorIndex].io, OWNER_MOTOR, RESOURCE_INDEX(motorIndex));
+            IOConfigGPIOAF(motors[motorIndex].io, IOCFG_AF_PP, timerHardware->alternateFunction);
+            pwmOutConfig(&motors[motorIndex], timerHardware, PWM_TIMER_MHZ_MAX,
+                getDshotUnitTicks(motorConfig->motorPwmProtocol) * (MOTOR_BITLENGTH + 1), 0, motorConfig->motorPwmInversion);
+#endif
             pwmDigitalMotorHardwareConfig(timerHardware, motorIndex, motorConfig->motorPwmProtocol,
                 motorConfig->motorPwmInversion ? timerHardware->output ^ TIMER_OUTPUT_INVERTED : timerHardware->output);
             motors[motorIndex].enabled = true;
@@ -591,6 +602,9 @@ void motorDevInit(const motorDevConfig_t *motorConfig, uint16_t idlePulse, uint8
         } else {
             pwmOutConfig(&motors[motorIndex], timerHardware, timerMhzCounter, 0xFFFF, 0, motorConfig->motorPwmInversion);
         }
+#ifdef XMC4500_F100x1024
+        pwmAddMotorShadowTransfer(timerHardware);
+#endif
 
         bool timerAlreadyUsed = false;
         for (int i = 0; i < motorIndex; i++) {
@@ -612,6 +626,29 @@ pwmOutputPort_t *pwmGetMotors(void)
     return motors;
 }
 
+#if defined(USE_ONBOARD_ESC) || defined(USE_DSHOT_TELEMETRY)
+// eRPM reported by the ESC of a motor, 0 while unknown
+uint32_t getMotorErpm(uint8_t motorIndex)
+{
+#ifdef USE_ONBOARD_ESC
+    return onboardEscGetErpm(motorIndex);
+#else
+    return useDshotTelemetry ? pwmGetDshotErpm(motorIndex) : 0;
+#endif
+}
+
+// true when the motors are driven by something that reports their speed to getMotorErpm()
+bool isMotorErpmAvailable(void)
+{
+#ifdef USE_ONBOARD_ESC
+    return onboardEscActive;
+#else
+    // only set for a DShot protocol with dshot_bidir on
+    return useDshotTelemetry;
+#endif
+}
+#endif
+
 #ifdef USE_DSHOT
 uint32_t getDshotHz(motorPwmProtocolTypes_e pwmProtocolType)
 {
@@ -628,13 +665,21 @@ uint32_t getDshotHz(motorPwmProtocolTypes_e pwmProtocolType)
     }
 }
 
+#ifdef XMC4500_F100x1024
+// Timer ticks per DShot bit unit with the CCU4 running at PWM_TIMER_MHZ_MAX
+uint32_t getDshotUnitTicks(motorPwmProtocolTypes_e pwmProtocolType)
+{
+    return PWM_TIMER_MHZ_MAX * 1000000 / getDshotHz(pwmProtocolType);
+}
+#endif
+
 void pwmWriteDshotCommand(uint8_t index, uint8_t command)
 {
     if (command <= DSHOT_MAX_COMMAND) {
         motorDmaOutput_t *const motor = getMotorDmaOutput(index);
 
         unsigned repeats;
-        if ((DSHOT_CMD_SPIN_ONE_WAY >= 7 && DSHOT_CMD_3D_MODE_ON <= 10) || DSHOT_CMD_SAVE_SETTINGS == 12 || (DSHOT_CMD_ROTATE_NORMAL >= 20 && DSHOT_CMD_ROTATE_REVERSE <= 21) ) {
+        if ((command >= DSHOT_CMD_SPIN_ONE_WAY && command <= DSHOT_CMD_3D_MODE_ON) || command == DSHOT_CMD_SAVE_SETTINGS || (command >= DSHOT_CMD_ROTATE_NORMAL && command <= DSHOT_CMD_ROTATE_REVERSE)) {
             repeats = 10;
         } else {
             repeats = 1;
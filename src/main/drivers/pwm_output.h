@@ -128,6 +128,12 @@ typedef struct {
     volatile bool requestTelemetry;
 #if defined(STM32F3) || defined(STM32F4) || defined(STM32F7)
     uint32_t dmaBuffer[MOTOR_DMA_BUFFER_SIZE];
+#elif defined(XMC4500_F100x1024)
+    uint8_t sliceIndex;     // column in the frame buffer shared by the CCU4 module
+#ifdef USE_DSHOT_TELEMETRY
+    uint32_t erpm;
+    uint16_t telemetryErrors;
+#endif
 #else
     uint8_t dmaBuffer[MOTOR_DMA_BUFFER_SIZE];
 #endif
@@ -156,7 +162,7 @@ typedef struct
     VADC_G_TypeDef *adc_group;
     uint8_t phase_channel[PHASE_CNT];
     int16_t delay_cnt;
-    float avg_delay;
+    int32_t avg_delay;              // Q8
     int16_t com_cnt;
     uint16_t disable_cnt;
     uint8_t crossing_detected;
@@ -164,6 +170,8 @@ typedef struct
     uint8_t startup;
     uint8_t emergency_stop;
     uint32_t emergency_stop_cnt;
+    uint16_t step_cnt;
+    uint16_t step_period;           // PWM periods between the last two commutations, 0 when stopped
 } pwmInverter_t;
 #endif
 
@@ -190,6 +198,9 @@ typedef struct motorDevConfig_s {
     uint8_t  motorPwmProtocol;              // Pwm Protocol
     uint8_t  motorPwmInversion;             // Active-High vs Active-Low. Useful for brushed FCs converted for brushless operation
     uint8_t  useUnsyncedPwm;
+#ifdef USE_DSHOT_TELEMETRY
+    uint8_t  useDshotTelemetry;             // Bidirectional DShot, the ESC returns its eRPM on the signal wire
+#endif
 #ifdef USE_ONBOARD_ESC
     ioTag_t  ioTags[MAX_SUPPORTED_MOTORS * INVERTER_OUT_CNT];
     uint16_t deadtime;
@@ -213,6 +224,9 @@ void pwmServoConfig(const struct timerHardware_s *timerHardware, uint8_t servoIn
 
 #ifdef USE_DSHOT
 uint32_t getDshotHz(motorPwmProtocolTypes_e pwmProtocolType);
+#ifdef XMC4500_F100x1024
+uint32_t getDshotUnitTicks(motorPwmProtocolTypes_e pwmProtocolType);
+#endif
 void pwmWriteDshotCommand(uint8_t index, uint8_t command);
 void pwmWriteDigital(uint8_t index, uint16_t value);
 void pwmDigitalMotorHardwareConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, motorPwmProtocolTypes_e pwmProtocolType, uint8_t output);
@@ -236,3 +250,17 @@ bool pwmIsSynced(void);
 void pwmDisableMotors(void);
 void pwmEnableMotors(void);
 bool pwmAreMotorsEnabled(void);
+
+#ifdef USE_ONBOARD_ESC
+uint32_t onboardEscGetErpm(uint8_t motorIndex);
+#endif
+
+#ifdef USE_DSHOT_TELEMETRY
+extern bool useDshotTelemetry;
+uint32_t pwmGetDshotErpm(uint8_t motorIndex);
+#endif
+
+#if defined(USE_ONBOARD_ESC) || defined(USE_DSHOT_TELEMETRY)
+uint32_t getMotorErpm(uint8_t motorIndex);
+bool isMotorErpmAvailable(void);
+#endif
@@ -0,0 +1,580 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_DSHOT
+
+#include "build/atomic.h"
+
+#include "common/maths.h"
+#include "common/utils.h"
+
+#include "drivers/dma.h"
+#include "drivers/io.h"
+#include "drivers/io_impl.h"
+#include "drivers/nvic.h"
+#include "drivers/timer.h"
+#include "drivers/pwm_output.h"
+
+/*
+ * DShot on the XMC4500 CCU4
+ *
+ * The motor slices of one CCU4 module run as plain PWM outputs with the DShot bit period and are
+ * started together by the SCU, so their period matches line up. The period match of the first
+ * motor slice is routed to service request SR0, which the DMA line router hands to two GPDMA0
+ * channels:
+ *  - channel 0 walks a linked list with one item per bit and writes the compare shadow registers
+ *    of all four slices of the module (destination scatter skips to the next slice)
+ *  - channel 1 requests the shadow transfer of the motor slices once per bit
+ * Compare values written during one bit are latched at the following period match, so the CPU
+ * only prepares the frame buffer once per motor update.
+ * The burst covers all four slices, so DShot is refused on a module that has slices in other use.
+ *
+ * Motor values written while a frame is out are latched and the next frame is started from the
+ * complete interrupt of whichever channel finishes last, so no update is lost to a busy DMA and
+ * the interrupt never waits on the other channel. Both channels share the GPDMA0 interrupt.
+ *
+ * With bidirectional DShot the outputs idle high and send inverted pulses. When the frame is out,
+ * the pins are switched to inputs and channel 0 samples the input register of their port with
+ * three times the reply bit rate, paced by the same slice with a shortened period. The GCR encoded
+ * eRPM replies of all motors are decoded from these samples before the next frame is started.
+ */
+
+#define DSHOT_FRAME_BITS            16
+#define DSHOT_CCU4_SLICE_COUNT      4
+#define DSHOT_CCU4_SLICE_STRIDE     0x100   // distance between the register blocks of two slices
+
+#define DSHOT_DMA                   XMC_DMA0
+#define DSHOT_DMA_COMPARE_CHANNEL   0       // linked lists and scatter are only available on GPDMA0 channel 0 and 1
+#define DSHOT_DMA_SHADOW_CHANNEL    1
+
+#define DSHOT_TELEMETRY_BITS        21      // start bit and 4 GCR encoded nibbles
+#define DSHOT_TELEMETRY_OVERSAMPLE  3
+#define DSHOT_TELEMETRY_DELAY_US    40      // ESCs answer 30us after the frame, with some margin
+#define DSHOT_TELEMETRY_SAMPLES_MAX 256
+#define DSHOT_TELEMETRY_INVALID     0xffff
+
+typedef enum {
+    DSHOT_STATE_IDLE = 0,
+    DSHOT_STATE_FRAME,
+    DSHOT_STATE_TELEMETRY,
+} dshotState_e;
+
+typedef struct {
+    XMC_CCU4_MODULE_t *module;
+    XMC_SCU_CCU_TRIGGER_t trigger;
+    uint8_t compareRequest;
+    uint8_t shadowRequest;
+} dshotModule_t;
+
+static const dshotModule_t dshotModules[] = {
+    { CCU40, XMC_SCU_CCU_TRIGGER_CCU40, DMA0_PERIPHERAL_REQUEST_CCU40_SR0_0, DMA0_PERIPHERAL_REQUEST_CCU40_SR0_1 },
+    { CCU41, XMC_SCU_CCU_TRIGGER_CCU41, DMA0_PERIPHERAL_REQUEST_CCU41_SR0_4, DMA0_PERIPHERAL_REQUEST_CCU41_SR0_5 },
+    { CCU42, XMC_SCU_CCU_TRIGGER_CCU42, DMA0_PERIPHERAL_REQUEST_CCU42_SR0_0, DMA0_PERIPHERAL_REQUEST_CCU42_SR0_1 },
+    { CCU43, XMC_SCU_CCU_TRIGGER_CCU43, DMA0_PERIPHERAL_REQUEST_CCU43_SR0_4, DMA0_PERIPHERAL_REQUEST_CCU43_SR0_5 },
+};
+
+static motorDmaOutput_t dmaMotors[MAX_SUPPORTED_MOTORS];
+static uint8_t dmaMotorCount;
+
+bool useDshotTelemetry = false;
+
+static const dshotModule_t *dshotModule = NULL;
+static bool dshotTimersStarted;
+static uint16_t dshotBit0Ticks;
+static uint16_t dshotBit1Ticks;
+static uint32_t dshotShadowTransferMask;
+
+// compare values of the four slices of the module, one row per bit, the last rows keep the line idle as frame reset
+static uint32_t dshotFrame[MOTOR_DMA_BUFFER_SIZE][DSHOT_CCU4_SLICE_COUNT];
+static XMC_DMA_LLI_t dshotFrameLli[MOTOR_DMA_BUFFER_SIZE];
+static XMC_DMA_CH_CONFIG_t dshotCompareDmaConfig;
+static XMC_DMA_CH_CONFIG_t dshotShadowDmaConfig;
+
+static volatile dshotState_e dshotState;
+static volatile bool dshotUpdatePending;    // motor values changed since the frame in flight was built
+
+#ifdef USE_DSHOT_TELEMETRY
+static uint16_t dshotBitPeriod;
+static uint16_t dshotSamplePeriod;
+static uint16_t dshotTelemetrySampleCount;
+static XMC_GPIO_PORT_t *dshotTelemetryPort;
+static uint32_t dshotTelemetrySamples[DSHOT_TELEMETRY_SAMPLES_MAX];
+static XMC_DMA_CH_CONFIG_t dshotTelemetryDmaConfig;
+#endif
+
+motorDmaOutput_t *getMotorDmaOutput(uint8_t index)
+{
+    return &dmaMotors[index];
+}
+
+static bool dshotDmaBusy(void)
+{
+    return dshotState != DSHOT_STATE_IDLE ||
+        XMC_DMA_CH_IsEnabled(DSHOT_DMA, DSHOT_DMA_COMPARE_CHANNEL) || XMC_DMA_CH_IsEnabled(DSHOT_DMA, DSHOT_DMA_SHADOW_CHANNEL);
+}
+
+static void dshotStartFrame(void);
+
+#ifdef USE_DSHOT_TELEMETRY
+uint32_t pwmGetDshotErpm(uint8_t motorIndex)
+{
+    if (motorIndex >= dmaMotorCount) {
+        return 0;
+    }
+    return dmaMotors[motorIndex].erpm;
+}
+
+// Changes the period of all motor slices with the next period match, all slices stay in phase
+static void dshotSetPeriod(uint16_t period)
+{
+    for (int i = 0; i < dmaMotorCount; i++) {
+        if (dmaMotors[i].timerHardware) {
+            XMC_CCU4_SLICE_SetTimerPeriodMatch((XMC_CCU4_SLICE_t *)dmaMotors[i].timerHardware->tim, period - 1);
+        }
+    }
+    XMC_CCU4_EnableShadowTransfer(dshotModule->module, dshotShadowTransferMask);
+}
+
+static void dshotSetPinsToInput(bool input)
+{
+    for (int i = 0; i < dmaMotorCount; i++) {
+        const timerHardware_t *timerHardware = dmaMotors[i].timerHardware;
+        if (timerHardware) {
+            const IO_t io = IOGetByTag(timerHardware->tag);
+            if (input) {
+                IOConfigGPIO(io, IOCFG_IPU);
+            } else {
+                IOConfigGPIOAF(io, IOCFG_AF_PP, timerHardware->alternateFunction);
+            }
+        }
+    }
+}
+
+static uint16_t dshotDecodeGcr(uint32_t value)
+{
+    static const uint8_t iv = 0xff;
+    static const uint8_t decode[32] = {
+        iv, iv, iv, iv, iv, iv, iv, iv, iv, 9, 10, 11, iv, 13, 14, 15,
+        iv, iv, 2, 3, iv, 5, 6, 7, iv, 0, 8, 1, iv, 4, 12, iv };
+
+    uint32_t decodedValue = 0;
+    for (int i = 0; i < 4; i++) {
+        const uint8_t nibble = decode[(value >> (5 * i)) & 0x1f];
+        if (nibble == iv) {
+            return DSHOT_TELEMETRY_INVALID;
+        }
+        decodedValue |= nibble << (4 * i);
+    }
+
+    uint32_t csum = decodedValue;
+    csum = csum ^ (csum >> 8); // xor bytes
+    csum = csum ^ (csum >> 4); // xor nibbles
+    if ((csum & 0xf) != 0xf) {
+        return DSHOT_TELEMETRY_INVALID;
+    }
+
+    return decodedValue >> 4;
+}
+
+// Rebuilds the 21 bit GCR word of one motor from the run lengths in the port samples
+static uint16_t dshotDecodeTelemetry(uint32_t pinMask)
+{
+    const uint32_t *samples = dshotTelemetrySamples;
+    int i = 0;
+
+    // the reply starts with the first falling edge on the idle high line
+    while (i < dshotTelemetrySampleCount && (samples[i] & pinMask)) {
+        i++;
+    }
+    if (i == dshotTelemetrySampleCount) {
+        return DSHOT_TELEMETRY_INVALID;
+    }
+
+    uint32_t value = 0;
+    int bits = 0;
+    int runStart = i;
+    uint32_t level = 0;
+    for (i++; i < dshotTelemetrySampleCount && bits < DSHOT_TELEMETRY_BITS; i++) {
+        if ((samples[i] & pinMask) != level) {
+            const int len = (i - runStart + DSHOT_TELEMETRY_OVERSAMPLE / 2) / DSHOT_TELEMETRY_OVERSAMPLE;
+            if (len == 0) {
+                return DSHOT_TELEMETRY_INVALID;
+            }
+            value = (value << len) | (1 << (len - 1));
+            bits += len;
+            runStart = i;
+            level ^= pinMask;
+        }
+    }
+
+    // the last high run merges into the idle line
+    if (bits < DSHOT_TELEMETRY_BITS && level) {
+        const int len = DSHOT_TELEMETRY_BITS - bits;
+        value = (value << len) | (1 << (len - 1));
+        bits += len;
+    }
+    if (bits != DSHOT_TELEMETRY_BITS) {
+        return DSHOT_TELEMETRY_INVALID;
+    }
+
+    return dshotDecodeGcr(value);   // the start bit is dropped with the upper bits
+}
+
+static void dshotProcessTelemetry(void)
+{
+    for (int i = 0; i < dmaMotorCount; i++) {
+        motorDmaOutput_t *const motor = &dmaMotors[i];
+        if (!motor->timerHardware) {
+            continue;
+        }
+
+        const uint16_t value = dshotDecodeTelemetry(1 << IO_Pin(IOGetByTag(motor->timerHardware->tag)));
+        if (value == DSHOT_TELEMETRY_INVALID) {
+            motor->telemetryErrors++;
+            continue;
+        }
+
+        // eeem mmmm mmmm is the electrical period in us as mantissa << exponent, 0x0fff means stopped
+        const uint32_t period = (value & 0x01ff) << (value >> 9);
+        motor->erpm = (value == 0x0fff || !period) ? 0 : 60 * 1000000 / period;
+    }
+}
+#endif
+
+static void dshotDmaIrqHandler(dmaChannelDescriptor_t *descriptor)
+{
+    UNUSED(descriptor);
+
+    XMC_DMA_CH_ClearEventStatus(DSHOT_DMA, DSHOT_DMA_COMPARE_CHANNEL, XMC_DMA_CH_EVENT_TRANSFER_COMPLETE | XMC_DMA_CH_EVENT_BLOCK_TRANSFER_COMPLETE);
+
+#ifdef USE_DSHOT_TELEMETRY
+    if (useDshotTelemetry) {
+        if (dshotState == DSHOT_STATE_FRAME) {
+            // the last bit is out, listen for the replies
+            dshotSetPinsToInput(true);
+            dshotSetPeriod(dshotSamplePeriod);
+            XMC_DMA_CH_Init(DSHOT_DMA, DSHOT_DMA_COMPARE_CHANNEL, &dshotTelemetryDmaConfig);
+            XMC_DMA_CH_Enable(DSHOT_DMA, DSHOT_DMA_COMPARE_CHANNEL);
+            dshotState = DSHOT_STATE_TELEMETRY;
+            return;
+        }
+        if (dshotState == DSHOT_STATE_TELEMETRY) {
+            dshotSetPeriod(dshotBitPeriod);
+            dshotSetPinsToInput(false);
+            // decode before a following frame reuses the sample buffer
+            dshotProcessTelemetry();
+        }
+    }
+#endif
+
+    dshotState = DSHOT_STATE_IDLE;
+
+    // the shadow channel takes the last request of the frame right after the compare channel,
+    // if it is still busy its own complete interrupt starts the next frame
+    if (dshotUpdatePending && !XMC_DMA_CH_IsEnabled(DSHOT_DMA, DSHOT_DMA_SHADOW_CHANNEL)) {
+        dshotStartFrame();
+    }
+}
+
+static void dshotShadowDmaIrqHandler(dmaChannelDescriptor_t *descriptor)
+{
+    UNUSED(descriptor);
+
+    XMC_DMA_CH_ClearEventStatus(DSHOT_DMA, DSHOT_DMA_SHADOW_CHANNEL, XMC_DMA_CH_EVENT_TRANSFER_COMPLETE | XMC_DMA_CH_EVENT_BLOCK_TRANSFER_COMPLETE);
+
+    // with telemetry the compare channel is still sampling the replies and starts the frame when done
+    if (dshotState == DSHOT_STATE_IDLE && dshotUpdatePending && !XMC_DMA_CH_IsEnabled(DSHOT_DMA, DSHOT_DMA_COMPARE_CHANNEL)) {
+        dshotStartFrame();
+    }
+}
+
+static uint16_t prepareDshotPacket(motorDmaOutput_t *const motor)
+{
+    // the telemetry bit requests a reply on the serial telemetry wire, bidirectional DShot always answers
+    uint16_t packet = (motor->value << 1) | (motor->requestTelemetry && !useDshotTelemetry ? 1 : 0);
+    motor->requestTelemetry = false;    // reset telemetry request to make sure it's triggered only once in a row
+
+    // compute checksum
+    int csum = 0;
+    int csum_data = packet;
+    for (int i = 0; i < 3; i++) {
+        csum ^= csum_data;   // xor data by nibbles
+        csum_data >>= 4;
+    }
+    // bidirectional DShot inverts the checksum so the ESC knows a reply is expected
+    if (useDshotTelemetry) {
+        csum = ~csum;
+    }
+    csum &= 0xf;
+    // append checksum
+    packet = (packet << 4) | csum;
+
+    return packet;
+}
+
+void pwmWriteDigital(uint8_t index, uint16_t value)
+{
+    motorDmaOutput_t *const motor = &dmaMotors[index];
+
+    // only latched here, the frame buffer is built when the next frame is started
+    if (motor->timerHardware) {
+        motor->value = value;
+    }
+}
+
+// Builds the frame buffer from the latched motor values and clocks it out, the DMA must be idle
+static void dshotStartFrame(void)
+{
+    dshotUpdatePending = false;
+
+    for (int i = 0; i < dmaMotorCount; i++) {
+        motorDmaOutput_t *const motor = &dmaMotors[i];
+        if (!motor->timerHardware) {
+            continue;
+        }
+
+        uint16_t packet = prepareDshotPacket(motor);
+        for (int bit = 0; bit < DSHOT_FRAME_BITS; bit++) {
+            dshotFrame[bit][motor->sliceIndex] = (packet & 0x8000) ? dshotBit1Ticks : dshotBit0Ticks;  // MSB first
+            packet <<= 1;
+        }
+    }
+
+    XMC_DMA_CH_Init(DSHOT_DMA, DSHOT_DMA_COMPARE_CHANNEL, &dshotCompareDmaConfig);
+    XMC_DMA_CH_Init(DSHOT_DMA, DSHOT_DMA_SHADOW_CHANNEL, &dshotShadowDmaConfig);
+    XMC_DMA_CH_EnableEvent(DSHOT_DMA, DSHOT_DMA_COMPARE_CHANNEL, XMC_DMA_CH_EVENT_TRANSFER_COMPLETE);
+    XMC_DMA_CH_EnableEvent(DSHOT_DMA, DSHOT_DMA_SHADOW_CHANNEL, XMC_DMA_CH_EVENT_BLOCK_TRANSFER_COMPLETE);
+    dshotState = DSHOT_STATE_FRAME;
+    XMC_DMA_CH_Enable(DSHOT_DMA, DSHOT_DMA_COMPARE_CHANNEL);
+    XMC_DMA_CH_Enable(DSHOT_DMA, DSHOT_DMA_SHADOW_CHANNEL);
+}
+
+void pwmCompleteDigitalMotorUpdate(uint8_t motorCount)
+{
+    UNUSED(motorCount);
+
+    if (!dshotModule) {
+        return;
+    }
+
+    if (!dshotTimersStarted) {
+        // start all slices of the module on the same clock, the period match of the first one paces the frame
+        XMC_SCU_SetCcuTriggerLow(dshotModule->trigger);
+        XMC_SCU_SetCcuTriggerHigh(dshotModule->trigger);
+        dshotTimersStarted = true;
+    }
+
+    ATOMIC_BLOCK(NVIC_PRIO_DSHOT_DMA) {
+        // a frame in flight picks the new values up from its complete interrupt
+        dshotUpdatePending = true;
+        if (!dshotDmaBusy()) {
+            dshotStartFrame();
+        }
+    }
+}
+
+// Compare values reach a slice only with its shadow transfer, which this driver requests for motor slices
+// only. A slice owned by another driver requests its own and would latch the DShot frame data.
+static bool dshotModuleIsMotorOnly(const dshotModule_t *module)
+{
+    for (int i = 0; i < USABLE_TIMER_CHANNEL_COUNT; i++) {
+        const timerHardware_t *timer = &timerHardware[i];
+        if (!timer->isCCU8 && timer->ccu_global == (uint32_t *)module->module && (timer->usageFlags & ~TIM_USE_MOTOR)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void dshotDmaConfig(const dshotModule_t *module, XMC_CCU4_SLICE_t *pacingSlice)
+{
+    const XMC_CCU4_SLICE_t *firstSlice = (XMC_CCU4_SLICE_t *)((uint32_t)module->module + DSHOT_CCU4_SLICE_STRIDE);
+
+    memset(dshotFrame, 0, sizeof(dshotFrame));
+
+    for (int i = 0; i < MOTOR_DMA_BUFFER_SIZE; i++) {
+        XMC_DMA_LLI_t *lli = &dshotFrameLli[i];
+        const bool last = (i == MOTOR_DMA_BUFFER_SIZE - 1);
+
+        memset(lli, 0, sizeof(*lli));
+        lli->src_addr = (uint32_t)dshotFrame[i];
+        lli->dst_addr = (uint32_t)&firstSlice->CRS;
+        lli->llp = last ? NULL : &dshotFrameLli[i + 1];
+        lli->dst_transfer_width = XMC_DMA_CH_TRANSFER_WIDTH_32;
+        lli->src_transfer_width = XMC_DMA_CH_TRANSFER_WIDTH_32;
+        lli->dst_address_count_mode = XMC_DMA_CH_ADDRESS_COUNT_MODE_INCREMENT;
+        lli->src_address_count_mode = XMC_DMA_CH_ADDRESS_COUNT_MODE_INCREMENT;
+        lli->dst_burst_length = XMC_DMA_CH_BURST_LENGTH_4;
+        lli->src_burst_length = XMC_DMA_CH_BURST_LENGTH_4;
+        lli->enable_dst_scatter = 1;
+        lli->transfer_flow = XMC_DMA_CH_TRANSFER_FLOW_M2P_DMA;
+        lli->enable_interrupt = 1;
+        lli->enable_dst_linked_list = !last;
+        lli->enable_src_linked_list = !last;
+        lli->block_size = DSHOT_CCU4_SLICE_COUNT;
+    }
+
+    memset(&dshotCompareDmaConfig, 0, sizeof(dshotCompareDmaConfig));
+    dshotCompareDmaConfig.dst_transfer_width = XMC_DMA_CH_TRANSFER_WIDTH_32;
+    dshotCompareDmaConfig.src_transfer_width = XMC_DMA_CH_TRANSFER_WIDTH_32;
+    dshotCompareDmaConfig.dst_address_count_mode = XMC_DMA_CH_ADDRESS_COUNT_MODE_INCREMENT;
+    dshotCompareDmaConfig.src_address_count_mode = XMC_DMA_CH_ADDRESS_COUNT_MODE_INCREMENT;
+    dshotCompareDmaConfig.dst_burst_length = XMC_DMA_CH_BURST_LENGTH_4;
+    dshotCompareDmaConfig.src_burst_length = XMC_DMA_CH_BURST_LENGTH_4;
+    dshotCompareDmaConfig.enable_dst_scatter = 1;
+    dshotCompareDmaConfig.transfer_flow = XMC_DMA_CH_TRANSFER_FLOW_M2P_DMA;
+    dshotCompareDmaConfig.enable_interrupt = 1;
+    dshotCompareDmaConfig.src_addr = dshotFrameLli[0].src_addr;
+    dshotCompareDmaConfig.dst_addr = dshotFrameLli[0].dst_addr;
+    dshotCompareDmaConfig.linked_list_pointer = &dshotFrameLli[0];
+    dshotCompareDmaConfig.dst_scatter_interval = DSHOT_CCU4_SLICE_STRIDE / sizeof(uint32_t) - 1;
+    dshotCompareDmaConfig.dst_scatter_count = 1;
+    dshotCompareDmaConfig.block_size = DSHOT_CCU4_SLICE_COUNT;
+    dshotCompareDmaConfig.transfer_type = XMC_DMA_CH_TRANSFER_TYPE_MULTI_BLOCK_SRCADR_LINKED_DSTADR_LINKED;
+    dshotCompareDmaConfig.priority = XMC_DMA_CH_PRIORITY_7;
+    dshotCompareDmaConfig.src_handshaking = XMC_DMA_CH_SRC_HANDSHAKING_SOFTWARE;
+    dshotCompareDmaConfig.dst_handshaking = XMC_DMA_CH_DST_HANDSHAKING_HARDWARE;
+    dshotCompareDmaConfig.dst_peripheral_request = module->compareRequest;
+
+    memset(&dshotShadowDmaConfig, 0, sizeof(dshotShadowDmaConfig));
+    dshotShadowDmaConfig.dst_transfer_width = XMC_DMA_CH_TRANSFER_WIDTH_32;
+    dshotShadowDmaConfig.src_transfer_width = XMC_DMA_CH_TRANSFER_WIDTH_32;
+    dshotShadowDmaConfig.dst_address_count_mode = XMC_DMA_CH_ADDRESS_COUNT_MODE_NO_CHANGE;
+    dshotShadowDmaConfig.src_address_count_mode = XMC_DMA_CH_ADDRESS_COUNT_MODE_NO_CHANGE;
+    dshotShadowDmaConfig.dst_burst_length = XMC_DMA_CH_BURST_LENGTH_1;
+    dshotShadowDmaConfig.src_burst_length = XMC_DMA_CH_BURST_LENGTH_1;
+    dshotShadowDmaConfig.transfer_flow = XMC_DMA_CH_TRANSFER_FLOW_M2P_DMA;
+    dshotShadowDmaConfig.enable_interrupt = 1;
+    dshotShadowDmaConfig.src_addr = (uint32_t)&dshotShadowTransferMask;
+    dshotShadowDmaConfig.dst_addr = (uint32_t)&module->module->GCSS;
+    dshotShadowDmaConfig.block_size = MOTOR_DMA_BUFFER_SIZE;
+    dshotShadowDmaConfig.transfer_type = XMC_DMA_CH_TRANSFER_TYPE_SINGLE_BLOCK;
+    dshotShadowDmaConfig.priority = XMC_DMA_CH_PRIORITY_6;
+    dshotShadowDmaConfig.src_handshaking = XMC_DMA_CH_SRC_HANDSHAKING_SOFTWARE;
+    dshotShadowDmaConfig.dst_handshaking = XMC_DMA_CH_DST_HANDSHAKING_HARDWARE;
+    dshotShadowDmaConfig.dst_peripheral_request = module->shadowRequest;
+
+#ifdef USE_DSHOT_TELEMETRY
+    memset(&dshotTelemetryDmaConfig, 0, sizeof(dshotTelemetryDmaConfig));
+    dshotTelemetryDmaConfig.dst_transfer_width = XMC_DMA_CH_TRANSFER_WIDTH_32;
+    dshotTelemetryDmaConfig.src_transfer_width = XMC_DMA_CH_TRANSFER_WIDTH_32;
+    dshotTelemetryDmaConfig.dst_address_count_mode = XMC_DMA_CH_ADDRESS_COUNT_MODE_INCREMENT;
+    dshotTelemetryDmaConfig.src_address_count_mode = XMC_DMA_CH_ADDRESS_COUNT_MODE_NO_CHANGE;
+    dshotTelemetryDmaConfig.dst_burst_length = XMC_DMA_CH_BURST_LENGTH_1;
+    dshotTelemetryDmaConfig.src_burst_length = XMC_DMA_CH_BURST_LENGTH_1;
+    dshotTelemetryDmaConfig.transfer_flow = XMC_DMA_CH_TRANSFER_FLOW_P2M_DMA;
+    dshotTelemetryDmaConfig.enable_interrupt = 1;
+    dshotTelemetryDmaConfig.src_addr = (uint32_t)&dshotTelemetryPort->IN;
+    dshotTelemetryDmaConfig.dst_addr = (uint32_t)dshotTelemetrySamples;
+    dshotTelemetryDmaConfig.block_size = dshotTelemetrySampleCount;
+    dshotTelemetryDmaConfig.transfer_type = XMC_DMA_CH_TRANSFER_TYPE_SINGLE_BLOCK;
+    dshotTelemetryDmaConfig.priority = XMC_DMA_CH_PRIORITY_7;
+    dshotTelemetryDmaConfig.src_handshaking = XMC_DMA_CH_SRC_HANDSHAKING_HARDWARE;
+    dshotTelemetryDmaConfig.src_peripheral_request = module->compareRequest;
+    dshotTelemetryDmaConfig.dst_handshaking = XMC_DMA_CH_DST_HANDSHAKING_SOFTWARE;
+#endif
+
+    dmaInit(DMA1_CH1_HANDLER, OWNER_MOTOR, 0);
+    dmaInit(DMA1_CH2_HANDLER, OWNER_MOTOR, 0);
+    dmaSetHandler(DMA1_CH1_HANDLER, dshotDmaIrqHandler, NVIC_PRIO_DSHOT_DMA, 0);
+    dmaSetHandler(DMA1_CH2_HANDLER, dshotShadowDmaIrqHandler, NVIC_PRIO_DSHOT_DMA, 0);
+
+    XMC_CCU4_SLICE_SetInterruptNode(pacingSlice, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH, XMC_CCU4_SLICE_SR_ID_0);
+    XMC_CCU4_SLICE_EnableEvent(pacingSlice, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+}
+
+void pwmDigitalMotorHardwareConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, motorPwmProtocolTypes_e pwmProtocolType, uint8_t output)
+{
+    UNUSED(output);     // the output level is set up with the slice in pwmOutConfig
+
+    motorDmaOutput_t * const motor = &dmaMotors[motorIndex];
+    XMC_CCU4_SLICE_t *slice = (XMC_CCU4_SLICE_t *)timerHardware->tim;
+    const dshotModule_t *module = NULL;
+
+    for (unsigned i = 0; i < ARRAYLEN(dshotModules); i++) {
+        if ((uint32_t *)dshotModules[i].module == timerHardware->ccu_global) {
+            module = &dshotModules[i];
+        }
+    }
+
+    // all motors have to share one CCU4 module that carries nothing but motors, others stay silent
+    if (timerHardware->isCCU8 || !module || (dshotModule && module != dshotModule) || !dshotModuleIsMotorOnly(module)) {
+        return;
+    }
+
+#ifdef USE_DSHOT_TELEMETRY
+    // the replies of all motors are sampled from one port input register
+    XMC_GPIO_PORT_t *port = IO_GPIO(IOGetByTag(timerHardware->tag));
+    if (useDshotTelemetry && dshotTelemetryPort && port != dshotTelemetryPort) {
+        return;
+    }
+    dshotTelemetryPort = port;
+#endif
+
+    motor->ioTag = timerHardware->tag;
+    motor->timerHardware = timerHardware;
+    motor->sliceIndex = ((uint32_t)slice - (uint32_t)module->module) / DSHOT_CCU4_SLICE_STRIDE - 1;
+    dmaMotorCount = MAX(dmaMotorCount, motorIndex + 1);
+
+    // hold the slice until all motors are configured and start them through the SCU
+    XMC_CCU4_SLICE_StopTimer(slice);
+    XMC_CCU4_SLICE_ClearTimer(slice);
+
+    // bidirectional DShot idles high and sends low pulses
+    XMC_CCU4_SLICE_SetPassiveLevel(slice, useDshotTelemetry ? XMC_CCU4_SLICE_OUTPUT_PASSIVE_LEVEL_LOW : XMC_CCU4_SLICE_OUTPUT_PASSIVE_LEVEL_HIGH);
+
+    XMC_CCU4_SLICE_EVENT_CONFIG_t event_config =
+    {
+        .mapped_input   = XMC_CCU4_SLICE_INPUT_I,
+        .edge           = XMC_CCU4_SLICE_EVENT_EDGE_SENSITIVITY_RISING_EDGE,
+        .duration       = XMC_CCU4_SLICE_EVENT_FILTER_DISABLED,
+    };
+    XMC_CCU4_SLICE_ConfigureEvent(slice, XMC_CCU4_SLICE_EVENT_0, &event_config);
+    XMC_CCU4_SLICE_StartConfig(slice, XMC_CCU4_SLICE_EVENT_0, XMC_CCU4_SLICE_START_MODE_TIMER_START_CLEAR);
+
+    if (!dshotModule) {
+        const uint32_t unitTicks = getDshotUnitTicks(pwmProtocolType);
+        dshotBit0Ticks = unitTicks * MOTOR_BIT_0;
+        dshotBit1Ticks = unitTicks * MOTOR_BIT_1;
+        dshotShadowTransferMask = 0;
+        dshotTimersStarted = false;
+        dshotState = DSHOT_STATE_IDLE;
+        dshotUpdatePending = false;
+
+#ifdef USE_DSHOT_TELEMETRY
+        // replies come with 5/4 of the bit rate
+        dshotBitPeriod = unitTicks * (MOTOR_BITLENGTH + 1);
+        dshotSamplePeriod = dshotBitPeriod * 4 / (5 * DSHOT_TELEMETRY_OVERSAMPLE);
+        dshotTelemetrySampleCount = MIN(DSHOT_TELEMETRY_SAMPLES_MAX,
+            DSHOT_TELEMETRY_DELAY_US * PWM_TIMER_MHZ_MAX / dshotSamplePeriod + DSHOT_TELEMETRY_BITS * DSHOT_TELEMETRY_OVERSAMPLE);
+#endif
+
+        dshotDmaConfig(module, slice);
+        dshotModule = module;
+    }
+
+    dshotShadowTransferMask |= (uint32_t)XMC_CCU4_SHADOW_TRANSFER_SLICE_0 << (4 * motor->sliceIndex);
+    XMC_CCU4_EnableShadowTransfer(module->module, dshotShadowTransferMask);
+}
+
+#endif
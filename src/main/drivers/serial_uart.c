@@ -24,11 +24,13 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
 #include "build/build_config.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 #include "drivers/gpio.h"
 #include "drivers/inverter.h"
@@ -197,16 +199,8 @@ uint8_t uartRead(serialPort_t *instance)
     return ch;
 }
 
-void uartWrite(serialPort_t *instance, uint8_t ch)
+static void uartStartTx(uartPort_t *s)
 {
-    uartPort_t *s = (uartPort_t *)instance;
-    s->port.txBuffer[s->port.txBufferHead] = ch;
-    if (s->port.txBufferHead + 1 >= s->port.txBufferSize) {
-        s->port.txBufferHead = 0;
-    } else {
-        s->port.txBufferHead++;
-    }
-
 #ifndef XMC4500_F100x1024
 #ifdef STM32F4
     if (s->txDMAStream) {
@@ -226,7 +220,7 @@ void uartWrite(serialPort_t *instance, uint8_t ch)
     }
     else
     {
-    	uartDevice_t *uartDev = uartDevmap[instance->identifier];
+    	uartDevice_t *uartDev = uartDevmap[s->port.identifier];
 		switch (uartDev->hardware->irqn_tx)
 		{
 			case USIC0_0_IRQn:
@@ -265,6 +259,44 @@ void uartWrite(serialPort_t *instance, uint8_t ch)
 #endif
 }
 
+void uartWrite(serialPort_t *instance, uint8_t ch)
+{
+    uartPort_t *s = (uartPort_t *)instance;
+    s->port.txBuffer[s->port.txBufferHead] = ch;
+    if (s->port.txBufferHead + 1 >= s->port.txBufferSize) {
+        s->port.txBufferHead = 0;
+    } else {
+        s->port.txBufferHead++;
+    }
+
+    uartStartTx(s);
+}
+
+// Copies the data into the tx ring in contiguous chunks, waiting for the tx interrupt to make room when it is full.
+static void uartWriteBuf(serialPort_t *instance, const void *data, int count)
+{
+    uartPort_t *s = (uartPort_t *)instance;
+    const uint8_t *p = data;
+
+    while (count > 0) {
+        uint32_t bytesFree;
+        while ((bytesFree = uartTotalTxBytesFree(instance)) == 0) {
+        }
+
+        const uint32_t chunk = MIN(MIN((uint32_t)count, bytesFree), s->port.txBufferSize - s->port.txBufferHead);
+        memcpy((uint8_t *)&s->port.txBuffer[s->port.txBufferHead], p, chunk);
+        if (s->port.txBufferHead + chunk >= s->port.txBufferSize) {
+            s->port.txBufferHead = 0;
+        } else {
+            s->port.txBufferHead += chunk;
+        }
+        p += chunk;
+        count -= chunk;
+
+        uartStartTx(s);
+    }
+}
+
 const struct serialPortVTable uartVTable[] = {
     {
         .serialWrite = uartWrite,
@@ -274,7 +306,7 @@ const struct serialPortVTable uartVTable[] = {
         .serialSetBaudRate = uartSetBaudRate,
         .isSerialTransmitBufferEmpty = isUartTransmitBufferEmpty,
         .setMode = uartSetMode,
-        .writeBuf = NULL,
+        .writeBuf = uartWriteBuf,
         .beginWrite = NULL,
         .endWrite = NULL,
     }
@@ -39,6 +39,7 @@ void failureMode(failureMode_e mode);
 void systemReset(void);
 void systemResetToBootloader(void);
 bool isMPUSoftReset(void);
+bool isMPUWarmBoot(void);
 void cycleCounterInit(void);
 void checkForBootLoaderRequest(void);
 
@@ -72,13 +72,16 @@ void enableGPIOPowerUsageAndNoiseReductions(void)
 #endif
 }
 
-//bool isMPUSoftReset(void)
-//{
-//    if (cachedRccCsrValue & RCC_CSR_SFTRSTF)
-//        return true;
-//    else
-//        return false;
-//}
+bool isMPUSoftReset(void)
+{
+    return cachedRccCsrValue & XMC_SCU_RESET_REASON_SW;
+}
+
+// any reset but power-on: software, watchdog, lockup or a supply brownout
+bool isMPUWarmBoot(void)
+{
+    return !(cachedRccCsrValue & XMC_SCU_RESET_REASON_PORST);
+}
 
 void SystemCoreClockSetup(void)
 {
@@ -144,9 +147,9 @@ void systemInit(void)
     // Configure NVIC preempt/priority groups
     NVIC_PriorityGroupConfig(NVIC_PRIORITY_GROUPING);
 //
-//    // cache RCC->CSR value to use it in isMPUSoftreset() and others
-//    cachedRccCsrValue = RCC->CSR;
-//    RCC_ClearFlag();
+    // cache the reset reason to use it in isMPUSoftReset() and others, then clear it for the next reset
+    cachedRccCsrValue = XMC_SCU_RESET_GetDeviceResetReason();
+    XMC_SCU_RESET_ClearDeviceResetReason();
 
     enableGPIOPowerUsageAndNoiseReductions();
 
@@ -80,6 +80,7 @@ extern uint8_t __config_end;
 #include "fc/config.h"
 #include "fc/controlrate_profile.h"
 #include "fc/fc_core.h"
+#include "fc/fc_init.h"
 #include "fc/rc_adjustments.h"
 #include "fc/rc_controls.h"
 #include "fc/runtime_config.h"
@@ -125,7 +126,8 @@ extern uint8_t __config_end;
 
 static serialPort_t *cliPort;
 static bufWriter_t *cliWriter;
-static uint8_t cliWriteBuffer[sizeof(*cliWriter) + 128];
+// output is flushed when this fills up, before each command and before the cli blocks or reboots
+static uint8_t cliWriteBuffer[sizeof(*cliWriter) + 512];
 
 static char cliBuffer[64];
 static uint32_t bufferIndex = 0;
@@ -189,7 +191,6 @@ static void cliPrint(const char *str)
     while (*str) {
         bufWriterAppend(cliWriter, *str++);
     }
-    bufWriterFlush(cliWriter);
 }
 
 static void cliPrintLinefeed()
@@ -231,13 +232,11 @@ typedef enum {
 static void cliPrintfva(const char *format, va_list va)
 {
     tfp_format(cliWriter, cliPutp, format, va);
-    bufWriterFlush(cliWriter);
 }
 
 static void cliPrintLinefva(const char *format, va_list va)
 {
     tfp_format(cliWriter, cliPutp, format, va);
-    bufWriterFlush(cliWriter);
     cliPrintLinefeed();
 }
 
@@ -344,25 +343,6 @@ static bool valuePtrEqualsDefault(uint8_t type, const void *ptr, const void *ptr
     return result;
 }
 
-static uint16_t getValueOffset(const clivalue_t *value)
-{
-    switch (value->type & VALUE_SECTION_MASK) {
-    case MASTER_VALUE:
-        return value->offset;
-    case PROFILE_VALUE:
-        return value->offset + sizeof(pidProfile_t) * getCurrentPidProfileIndex();
-    case PROFILE_RATE_VALUE:
-        return value->offset + sizeof(controlRateConfig_t) * getCurrentControlRateProfileIndex();
-    }
-    return 0;
-}
-
-static void *getValuePointer(const clivalue_t *value)
-{
-    const pgRegistry_t* rec = pgFind(value->pgn);
-    return CONST_CAST(void *, rec->address + getValueOffset(value));
-}
-
 static void dumpPgValue(const clivalue_t *value, uint8_t dumpMask)
 {
     const pgRegistry_t *pg = pgFind(value->pgn);
@@ -375,7 +355,7 @@ static void dumpPgValue(const clivalue_t *value, uint8_t dumpMask)
 
     const char *format = "set %s = ";
     const char *defaultFormat = "#set %s = ";
-    const int valueOffset = getValueOffset(value);
+    const int valueOffset = settingGetValueOffset(value);
     const bool equalsDefault = valuePtrEqualsDefault(value->type, pg->copy + valueOffset, pg->address + valueOffset);
     if (((dumpMask & DO_DIFF) == 0) || !equalsDefault) {
         if (dumpMask & SHOW_DEFAULTS && !equalsDefault) {
@@ -393,7 +373,6 @@ static void dumpAllValues(uint16_t valueSection, uint8_t dumpMask)
 {
     for (uint32_t i = 0; i < valueTableEntryCount; i++) {
         const clivalue_t *value = &valueTable[i];
-        bufWriterFlush(cliWriter);
         if ((value->type & VALUE_SECTION_MASK) == valueSection) {
             dumpPgValue(value, dumpMask);
         }
@@ -402,7 +381,7 @@ static void dumpAllValues(uint16_t valueSection, uint8_t dumpMask)
 
 static void cliPrintVar(const clivalue_t *var, bool full)
 {
-    const void *ptr = getValuePointer(var);
+    const void *ptr = settingGetValuePointer(var);
 
     printValuePointer(var, ptr, full);
 }
@@ -430,7 +409,7 @@ static void cliPrintVarRange(const clivalue_t *var)
 
 static void cliSetVar(const clivalue_t *var, const cliVar_t value)
 {
-    void *ptr = getValuePointer(var);
+    void *ptr = settingGetValuePointer(var);
 
     switch (var->type & VALUE_TYPE_MASK) {
     case VAR_UINT8:
@@ -2495,6 +2474,17 @@ static void cliGet(char *cmdline)
     const clivalue_t *val;
     int matchedCommands = 0;
 
+    // an exact name only shows that setting, anything else lists all settings containing it
+    val = settingFind(cmdline, strlen(cmdline));
+    if (val) {
+        cliPrintf("%s = ", val->name);
+        cliPrintVar(val, 0);
+        cliPrintLinefeed();
+        cliPrintVarRange(val);
+        cliPrintLinefeed();
+        return;
+    }
+
     for (uint32_t i = 0; i < valueTableEntryCount; i++) {
         if (strstr(valueTable[i].name, cmdline)) {
             val = &valueTable[i];
@@ -2547,49 +2537,46 @@ static void cliSet(char *cmdline)
             eqptr++;
         }
 
-        for (uint32_t i = 0; i < valueTableEntryCount; i++) {
-            val = &valueTable[i];
-            // ensure exact match when setting to prevent setting variables with shorter names
-            if (strncasecmp(cmdline, valueTable[i].name, strlen(valueTable[i].name)) == 0 && variableNameLength == strlen(valueTable[i].name)) {
-
-                bool changeValue = false;
-                cliVar_t value  = { .int16 = 0 };
-                switch (valueTable[i].type & VALUE_MODE_MASK) {
-                    case MODE_DIRECT: {
-                            value.int16 = atoi(eqptr);
+        // exact match only, to prevent setting variables with shorter names
+        val = settingFind(cmdline, variableNameLength);
+        if (val) {
+            bool changeValue = false;
+            cliVar_t value  = { .int16 = 0 };
+            switch (val->type & VALUE_MODE_MASK) {
+                case MODE_DIRECT: {
+                        value.int16 = atoi(eqptr);
 
-                            if (value.int16 >= valueTable[i].config.minmax.min && value.int16 <= valueTable[i].config.minmax.max) {
-                                changeValue = true;
-                            }
+                        if (value.int16 >= val->config.minmax.min && value.int16 <= val->config.minmax.max) {
+                            changeValue = true;
                         }
-                        break;
-                    case MODE_LOOKUP: {
-                            const lookupTableEntry_t *tableEntry = &lookupTables[valueTable[i].config.lookup.tableIndex];
-                            bool matched = false;
-                            for (uint32_t tableValueIndex = 0; tableValueIndex < tableEntry->valueCount && !matched; tableValueIndex++) {
-                                matched = strcasecmp(tableEntry->values[tableValueIndex], eqptr) == 0;
-
-                                if (matched) {
-                                    value.int16 = tableValueIndex;
-                                    changeValue = true;
-                                }
+                    }
+                    break;
+                case MODE_LOOKUP: {
+                        const lookupTableEntry_t *tableEntry = &lookupTables[val->config.lookup.tableIndex];
+                        bool matched = false;
+                        for (uint32_t tableValueIndex = 0; tableValueIndex < tableEntry->valueCount && !matched; tableValueIndex++) {
+                            matched = strcasecmp(tableEntry->values[tableValueIndex], eqptr) == 0;
+
+                            if (matched) {
+                                value.int16 = tableValueIndex;
+                                changeValue = true;
                             }
                         }
-                        break;
-                }
-
-                if (changeValue) {
-                    cliSetVar(val, value);
+                    }
+                    break;
+            }
 
-                    cliPrintf("%s set to ", valueTable[i].name);
-                    cliPrintVar(val, 0);
-                } else {
-                    cliPrintLine("Invalid value");
-                    cliPrintVarRange(val);
-                }
+            if (changeValue) {
+                cliSetVar(val, value);
 
-                return;
+                cliPrintf("%s set to ", val->name);
+                cliPrintVar(val, 0);
+            } else {
+                cliPrintLine("Invalid value");
+                cliPrintVarRange(val);
             }
+
+            return;
         }
         cliPrintLine("Invalid name");
     } else {
@@ -2642,6 +2629,16 @@ static void cliStatus(char *cmdline)
     cliPrintLinef("Stack size: %d, Stack address: 0x%x", stackTotalSize(), stackHighMem());
 
     cliPrintLinef("I2C Errors: %d, config size: %d, max available config: %d", i2cErrorCounter, getEEPROMConfigSize(), &__config_end - &__config_start);
+#ifdef USE_I2C
+    cliPrintLinef("I2C transactions: %u, bytes: %u", i2cGetTransactionCounter(), i2cGetByteCounter());
+#endif
+
+    cliPrintf("Boot ms:");
+    static const char * const bootPhaseNames[BOOT_PHASE_COUNT] = { "config", "periph", "sensors", "signal", "subsys", "ready" };
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+        cliPrintf(" %s %u", bootPhaseNames[i], bootPhaseEndUs[i] / 1000);
+    }
+    cliPrintLinef("%s", fastBoot ? " (fast)" : "");
 
     const int gyroRate = getTaskDeltaTime(TASK_GYROPID) == 0 ? 0 : (int)(1000000.0f / ((float)getTaskDeltaTime(TASK_GYROPID)));
     const int rxRate = getTaskDeltaTime(TASK_RX) == 0 ? 0 : (int)(1000000.0f / ((float)getTaskDeltaTime(TASK_RX)));
@@ -3389,6 +3386,8 @@ void cliProcess(void)
                         break;
                     }
                 }
+                // commands may also print directly with tfp_printf, keep the order
+                bufWriterFlush(cliWriter);
                 if(cmd < cmdTable + ARRAYLEN(cmdTable))
                     cmd->func(options);
                 else
@@ -126,7 +126,8 @@ PG_RESET_TEMPLATE(systemConfig_t, systemConfig,
     .activeRateProfile = 0,
     .debug_mode = DEBUG_MODE,
     .task_statistics = true,
-    .name = { 0 } // FIXME misplaced, see PG_PILOT_CONFIG in CF v1.x
+    .name = { 0 }, // FIXME misplaced, see PG_PILOT_CONFIG in CF v1.x
+    .fast_boot = false
 );
 #endif
 
@@ -338,6 +339,7 @@ void activateConfig(void)
 {
 #ifndef USE_OSD_SLAVE
     generateThrottleCurve();
+    generateRateCurves();
 
     resetAdjustmentStates();
 
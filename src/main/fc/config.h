@@ -73,6 +73,7 @@ typedef struct systemConfig_s {
     uint8_t debug_mode;
     uint8_t task_statistics;
     char name[MAX_NAME_LENGTH + 1]; // FIXME misplaced, see PG_PILOT_CONFIG in CF v1.x
+    uint8_t fast_boot;              // skip the startup led/beeper signal after a warm reset
 } systemConfig_t;
 #endif
 
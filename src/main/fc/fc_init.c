@@ -145,6 +145,15 @@ serialPort_t *loopbackPort;
 
 uint8_t systemState = SYSTEM_STATE_INITIALISING;
 
+uint32_t bootPhaseEndUs[BOOT_PHASE_COUNT];
+// warm boot with fast_boot enabled, the led/beeper startup signal is skipped
+bool fastBoot = false;
+
+static void bootPhaseDone(bootPhase_e phase)
+{
+    bootPhaseEndUs[phase] = micros();
+}
+
 void processLoopback(void)
 {
 #ifdef SOFTSERIAL_LOOPBACK
@@ -213,6 +222,11 @@ void init(void)
 
     systemState |= SYSTEM_STATE_CONFIG_LOADED;
 
+#ifndef USE_OSD_SLAVE
+    fastBoot = systemConfig()->fast_boot && isMPUWarmBoot();
+#endif
+    bootPhaseDone(BOOT_PHASE_CONFIG);
+
     //i2cSetOverclock(masterConfig.i2c_overclock);
 
     debugMode = systemConfig()->debug_mode;
@@ -414,6 +428,8 @@ void init(void)
     adcInit(adcConfig());
 #endif
 
+    bootPhaseDone(BOOT_PHASE_PERIPHERALS);
+
     initBoardAlignment(boardAlignment());
 
     if (!sensorsAutodetect()) {
@@ -422,12 +438,13 @@ void init(void)
     }
 
     systemState |= SYSTEM_STATE_SENSORS_READY;
+    bootPhaseDone(BOOT_PHASE_SENSORS);
 
     LED1_ON;
     LED0_OFF;
     LED2_OFF;
 
-    for (int i = 0; i < 10; i++) {
+    for (int i = 0; i < 10 && !fastBoot; i++) {
         LED1_TOGGLE;
         LED0_TOGGLE;
         delay(25);
@@ -437,6 +454,7 @@ void init(void)
     }
     LED0_OFF;
     LED1_OFF;
+    bootPhaseDone(BOOT_PHASE_INIT_SIGNAL);
 
     // gyro.targetLooptime set in sensorsAutodetect(), so we are ready to call pidInit()
     pidInit(currentPidProfile);
@@ -630,6 +648,8 @@ void init(void)
     latchActiveFeatures();
     motorControlEnable = true;
 
+    bootPhaseDone(BOOT_PHASE_SUBSYSTEMS);
+
 #ifdef USE_OSD_SLAVE
     osdSlaveTasksInit();
 #else
@@ -641,4 +661,5 @@ void init(void)
 #endif // USE_RCSPLIT
 
     systemState |= SYSTEM_STATE_READY;
+    bootPhaseDone(BOOT_PHASE_READY);
 }
@@ -28,5 +28,19 @@ typedef enum {
 
 extern uint8_t systemState;
 
+typedef enum {
+    BOOT_PHASE_CONFIG = 0,      // eeprom validated and loaded
+    BOOT_PHASE_PERIPHERALS,     // motors, serial ports, buses and adc
+    BOOT_PHASE_SENSORS,         // sensor detection and init
+    BOOT_PHASE_INIT_SIGNAL,     // led/beeper startup signal
+    BOOT_PHASE_SUBSYSTEMS,      // rx, displays, telemetry, logging, vtx
+    BOOT_PHASE_READY,           // tasks started
+    BOOT_PHASE_COUNT
+} bootPhase_e;
+
+// micros() at the end of each init phase
+extern uint32_t bootPhaseEndUs[BOOT_PHASE_COUNT];
+extern bool fastBoot;
+
 void init(void);
 void processLoopback(void);
@@ -63,6 +63,7 @@
 #include "fc/rc_controls.h"
 #include "fc/rc_modes.h"
 #include "fc/runtime_config.h"
+#include "fc/settings.h"
 
 #include "flight/altitude.h"
 #include "flight/failsafe.h"
@@ -1095,6 +1096,15 @@ static bool mspFcProcessOutCommand(uint8_t cmdMSP, sbuf_t *dst, mspPostProcessFn
         sbufWriteU16(dst, motorConfig()->mincommand);
         break;
 
+#if defined(USE_ONBOARD_ESC) || defined(USE_DSHOT_TELEMETRY)
+    case MSP_MOTOR_TELEMETRY:
+        sbufWriteU8(dst, getMotorCount());
+        for (unsigned i = 0; i < getMotorCount(); i++) {
+            sbufWriteU32(dst, getMotorErpm(i) * 2 / motorConfig()->motorPoleCount);
+        }
+        break;
+#endif
+
 #ifdef MAG
     case MSP_COMPASS_CONFIG:
         sbufWriteU16(dst, compassConfig()->mag_declination / 10);
@@ -1367,6 +1377,32 @@ static bool mspFcProcessOutCommand(uint8_t cmdMSP, sbuf_t *dst, mspPostProcessFn
     return true;
 }
 
+// the setting name is terminated by '\0' or the end of the payload
+static const clivalue_t *mspReadSettingName(sbuf_t *src)
+{
+    const char *name = (const char *)sbufPtr(src);
+    const int remaining = sbufBytesRemaining(src);
+    int length = 0;
+
+    while (length < remaining && length < UINT8_MAX && name[length] != '\0') {
+        length++;
+    }
+    sbufAdvance(src, MIN(length + 1, remaining));
+
+    return settingFind(name, length);
+}
+
+static void mspGetSettingRange(const clivalue_t *setting, int16_t *min, int16_t *max)
+{
+    if ((setting->type & VALUE_MODE_MASK) == MODE_LOOKUP) {
+        *min = 0;
+        *max = lookupTables[setting->config.lookup.tableIndex].valueCount - 1;
+    } else {
+        *min = setting->config.minmax.min;
+        *max = setting->config.minmax.max;
+    }
+}
+
 static mspResult_e mspFcProcessOutCommandWithArg(uint8_t cmdMSP, sbuf_t *arg, sbuf_t *dst, mspPostProcessFnPtr *mspPostProcessFn)
 {
     UNUSED(mspPostProcessFn);
@@ -1384,6 +1420,36 @@ static mspResult_e mspFcProcessOutCommandWithArg(uint8_t cmdMSP, sbuf_t *arg, sb
             serializeBoxReply(dst, page, &serializeBoxPermanentIdFn);
         }
         break;
+    case MSP_SETTING:
+        {
+            const clivalue_t *setting = mspReadSettingName(arg);
+            if (!setting) {
+                return MSP_RESULT_ERROR;
+            }
+
+            const void *ptr = settingGetValuePointer(setting);
+            int16_t value;
+            switch (setting->type & VALUE_TYPE_MASK) {
+            case VAR_UINT8:
+                value = *(uint8_t *)ptr;
+                break;
+            case VAR_INT8:
+                value = *(int8_t *)ptr;
+                break;
+            default:
+                value = *(int16_t *)ptr;
+                break;
+            }
+
+            int16_t min, max;
+            mspGetSettingRange(setting, &min, &max);
+
+            sbufWriteU8(dst, setting->type);
+            sbufWriteU16(dst, value);
+            sbufWriteU16(dst, min);
+            sbufWriteU16(dst, max);
+        }
+        break;
     default:
         return MSP_RESULT_CMD_UNKNOWN;
     }
@@ -1575,6 +1641,7 @@ static mspResult_e mspFcProcessInCommand(uint8_t cmdMSP, sbuf_t *src)
                 currentControlRateProfile->rcYawRate8 = sbufReadU8(src);
             }
             generateThrottleCurve();
+            generateRateCurves();
         } else {
             return MSP_RESULT_ERROR;
         }
@@ -1968,6 +2035,7 @@ static mspResult_e mspFcProcessInCommand(uint8_t cmdMSP, sbuf_t *src)
             color->s = sbufReadU8(src);
             color->v = sbufReadU8(src);
         }
+        reevaluateLedConfig();
         break;
 
     case MSP_SET_LED_STRIP_CONFIG:
@@ -2001,6 +2069,35 @@ static mspResult_e mspFcProcessInCommand(uint8_t cmdMSP, sbuf_t *src)
         }
         break;
 
+    case MSP_SET_SETTING:
+        {
+            const clivalue_t *setting = mspReadSettingName(src);
+            if (!setting || sbufBytesRemaining(src) < 2) {
+                return MSP_RESULT_ERROR;
+            }
+
+            const int16_t value = sbufReadU16(src);
+            int16_t min, max;
+            mspGetSettingRange(setting, &min, &max);
+            if (value < min || value > max) {
+                return MSP_RESULT_ERROR;
+            }
+
+            void *ptr = settingGetValuePointer(setting);
+            switch (setting->type & VALUE_TYPE_MASK) {
+            case VAR_UINT8:
+                *(uint8_t *)ptr = value;
+                break;
+            case VAR_INT8:
+                *(int8_t *)ptr = value;
+                break;
+            default:
+                *(int16_t *)ptr = value;
+                break;
+            }
+        }
+        break;
+
     default:
         // we do not know how to handle the (valid) message, indicate error MSP $M!
         return MSP_RESULT_ERROR;
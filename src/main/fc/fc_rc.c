@@ -97,7 +97,12 @@ int16_t rcLookupThrottle(int32_t tmp)
 #define SETPOINT_RATE_LIMIT 1998.0f
 #define RC_RATE_INCREMENTAL 14.54f
 
-static void calculateSetpointRate(int axis)
+#define RC_RATE_LOOKUP_STEP     5                                   // rcCommand between two points of the rate curve
+#define RC_RATE_LOOKUP_LENGTH   (500 / RC_RATE_LOOKUP_STEP + 2)
+static float lookupRateRC[3][RC_RATE_LOOKUP_LENGTH];                // angle rate over absolute rcCommand, the curve is odd
+
+// Angle rate for a positive stick deflection [0;1] with rc rate, expo and super rate of the axis
+static float calculateRate(int axis, float rcCommandf)
 {
     uint8_t rcExpo;
     float rcRate;
@@ -112,10 +117,7 @@ static void calculateSetpointRate(int axis)
         rcRate += RC_RATE_INCREMENTAL * (rcRate - 2.0f);
     }
 
-    float rcCommandf = rcCommand[axis] / 500.0f;
-    rcDeflection[axis] = rcCommandf;
-    const float rcCommandfAbs = ABS(rcCommandf);
-    rcDeflectionAbs[axis] = rcCommandfAbs;
+    const float rcCommandfAbs = rcCommandf;
 
     if (rcExpo) {
         const float expof = rcExpo / 100.0f;
@@ -128,6 +130,33 @@ static void calculateSetpointRate(int axis)
         angleRate *= rcSuperfactor;
     }
 
+    return angleRate;
+}
+
+void generateRateCurves(void)
+{
+    for (int axis = 0; axis < 3; axis++) {
+        for (int i = 0; i < RC_RATE_LOOKUP_LENGTH; i++) {
+            lookupRateRC[axis][i] = calculateRate(axis, MIN(i * RC_RATE_LOOKUP_STEP, 500) / 500.0f);
+        }
+    }
+}
+
+static void calculateSetpointRate(int axis)
+{
+    const float rcCommandf = rcCommand[axis] * (1.0f / 500.0f);
+    rcDeflection[axis] = rcCommandf;
+    const float rcCommandfAbs = ABS(rcCommandf);
+    rcDeflectionAbs[axis] = rcCommandfAbs;
+
+    // [0;500] -> rate curve, interpolated between the points
+    const float position = MIN(rcCommandfAbs, 1.0f) * (500 / RC_RATE_LOOKUP_STEP);
+    const int index = position;
+    float angleRate = lookupRateRC[axis][index] + (position - index) * (lookupRateRC[axis][index + 1] - lookupRateRC[axis][index]);
+    if (rcCommandf < 0) {
+        angleRate = -angleRate;
+    }
+
     DEBUG_SET(DEBUG_ANGLERATE, axis, angleRate);
 
     setpointRate[axis] = constrainf(angleRate, -SETPOINT_RATE_LIMIT, SETPOINT_RATE_LIMIT); // Rate limit protection (deg/sec)
@@ -173,6 +202,49 @@ static void scaleRcCommandToFpvCamAngle(void) {
         pidSetItermAccelerator(1.0f);
 }
 
+// PT1 cutoff at a quarter of the measured RX frame rate, limited to what the filter can hold
+#define RC_SMOOTHING_FILTER_RATE_DIVISOR 4
+
+static uint8_t rcSmoothingFilterCutoff(uint16_t rxRefreshRate)
+{
+    const uint32_t cutoffHz = 1000000 / (rxRefreshRate * RC_SMOOTHING_FILTER_RATE_DIVISOR);
+    const uint32_t pidNyquistHz = 1000000 / (targetPidLooptime * 2);
+
+    return constrain(MIN(cutoffHz, pidNyquistHz), 1, UINT8_MAX);
+}
+
+static void processRcSmoothingFilter(uint16_t rxRefreshRate, uint8_t channelCount)
+{
+    static pt1Filter_t rcCommandFilter[4];
+    static float rcCommandRaw[4];
+    static uint8_t rcCommandFilterCutoff;
+
+    if (isRXDataNew) {
+        // Only retune when the RX interval moved noticeably, the filter state is kept
+        const uint8_t cutoffHz = rcSmoothingFilterCutoff(rxRefreshRate);
+        if (ABS(cutoffHz - rcCommandFilterCutoff) > rcCommandFilterCutoff / 10) {
+            rcCommandFilterCutoff = cutoffHz;
+            for (int channel = ROLL; channel < 4; channel++) {
+                pt1FilterInit(&rcCommandFilter[channel], cutoffHz, targetPidLooptime * 0.000001f);
+            }
+        }
+
+        for (int channel = ROLL; channel < channelCount; channel++) {
+            rcCommandRaw[channel] = rcCommand[channel];
+        }
+
+        if (debugMode == DEBUG_RC_INTERPOLATION) {
+            debug[0] = lrintf(rcCommand[0]);
+            debug[1] = lrintf(getTaskDeltaTime(TASK_RX) / 1000);
+            debug[2] = rcCommandFilterCutoff;
+        }
+    }
+
+    for (int channel = ROLL; channel < channelCount; channel++) {
+        rcCommand[channel] = pt1FilterApply(&rcCommandFilter[channel], rcCommandRaw[channel]);
+    }
+}
+
 void processRcCommand(void)
 {
     static float rcCommandInterp[4] = { 0, 0, 0, 0 };
@@ -191,7 +263,12 @@ void processRcCommand(void)
         }
     }
 
-    if (rxConfig()->rcInterpolation) {
+    if (rxConfig()->rcInterpolation == RC_SMOOTHING_FILTER) {
+        // Filter the commands every PID loop, so setpoint and feed forward see a continuous signal
+        processRcSmoothingFilter(currentRxRefreshRate, interpolationChannels);
+        readyToCalculateRate = true;
+        readyToCalculateRateAxisCnt = FD_YAW;
+    } else if (rxConfig()->rcInterpolation) {
          // Set RC refresh rate for sampling and channels to filter
         switch(rxConfig()->rcInterpolation) {
             case(RC_SMOOTHING_AUTO):
@@ -209,8 +286,9 @@ void processRcCommand(void)
         if (isRXDataNew && rxRefreshRate > 0) {
             rcInterpolationStepCount = rxRefreshRate / targetPidLooptime;
 
+            const float stepScale = rcInterpolationStepCount > 0 ? 1.0f / rcInterpolationStepCount : 0.0f;
             for (int channel=ROLL; channel < interpolationChannels; channel++) {
-                rcStepSize[channel] = (rcCommand[channel] - rcCommandInterp[channel]) / (float)rcInterpolationStepCount;
+                rcStepSize[channel] = (rcCommand[channel] - rcCommandInterp[channel]) * stepScale;
             }
 
             if (debugMode == DEBUG_RC_INTERPOLATION) {
@@ -244,7 +322,9 @@ void processRcCommand(void)
             calculateSetpointRate(axis);
 
         if (debugMode == DEBUG_RC_INTERPOLATION) {
-            debug[2] = rcInterpolationStepCount;
+            if (rxConfig()->rcInterpolation != RC_SMOOTHING_FILTER) {
+                debug[2] = rcInterpolationStepCount;
+            }
             debug[3] = setpointRate[0];
         }
         // Scaling of AngleRate to camera angle (Mixing Roll and Yaw)
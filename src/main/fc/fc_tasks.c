@@ -29,6 +29,7 @@
 #include "common/color.h"
 #include "common/utils.h"
 #include "common/filter.h"
+#include "common/maths.h"
 
 #include "config/feature.h"
 #include "config/parameter_group.h"
@@ -199,7 +200,7 @@ static void taskUpdateBaro(timeUs_t currentTimeUs)
 }
 #endif
 
-#if defined(BARO) || defined(SONAR)
+#if defined(BARO) || defined(SONAR) || defined(RADAR)
 static void taskCalculateAltitude(timeUs_t currentTimeUs)
 {
     if (false
@@ -208,6 +209,9 @@ static void taskCalculateAltitude(timeUs_t currentTimeUs)
 #endif
 #if defined(SONAR)
         || sensors(SENSOR_SONAR)
+#endif
+#if defined(RADAR)
+        || sensors(SENSOR_RADAR)
 #endif
         ) {
         calculateEstimatedAltitude(currentTimeUs);
@@ -277,6 +281,7 @@ void fcTasksInit(void)
     }
 
     setTaskEnabled(TASK_ATTITUDE, sensors(SENSOR_ACC));
+    rescheduleTask(TASK_ATTITUDE, MAX(TASK_PERIOD_HZ(imuConfig()->update_rate_hz), gyro.targetLooptime));
     setTaskEnabled(TASK_SERIAL, true);
     rescheduleTask(TASK_SERIAL, TASK_PERIOD_HZ(serialConfig()->serial_update_rate_hz));
 
@@ -311,8 +316,16 @@ void fcTasksInit(void)
 #ifdef SONAR
     setTaskEnabled(TASK_SONAR, sensors(SENSOR_SONAR));
 #endif
-#if defined(BARO) || defined(SONAR)
-    setTaskEnabled(TASK_ALTITUDE, sensors(SENSOR_BARO) || sensors(SENSOR_SONAR));
+#if defined(BARO) || defined(SONAR) || defined(RADAR)
+    setTaskEnabled(TASK_ALTITUDE, sensors(SENSOR_BARO) || sensors(SENSOR_SONAR)
+#ifdef RADAR
+        || sensors(SENSOR_RADAR)
+#endif
+        );
+    if (barometerConfig()->baro_kalman) {
+        // the kalman estimator predicts with every batch of IMU acceleration samples
+        rescheduleTask(TASK_ALTITUDE, MAX(TASK_PERIOD_HZ(imuConfig()->update_rate_hz), gyro.targetLooptime));
+    }
 #endif
 #ifdef RADAR
     setTaskEnabled(TASK_RADAR, sensors(SENSOR_RADAR));
@@ -519,7 +532,7 @@ cfTask_t cfTasks[TASK_COUNT] = {
     },
 #endif
 
-#if defined(BARO) || defined(SONAR)
+#if defined(BARO) || defined(SONAR) || defined(RADAR)
     [TASK_ALTITUDE] = {
         .taskName = "ALTITUDE",
         .taskFunc = taskCalculateAltitude,
@@ -67,6 +67,7 @@
 #include "sensors/compass.h"
 #include "sensors/esc_sensor.h"
 #include "sensors/gyro.h"
+#include "sensors/gyroanalyse.h"
 
 #include "telemetry/frsky.h"
 #include "telemetry/telemetry.h"
@@ -231,7 +232,7 @@ static const char * const lookupTablePwmProtocol[] = {
 };
 
 static const char * const lookupTableRcInterpolation[] = {
-    "OFF", "PRESET", "AUTO", "MANUAL"
+    "OFF", "PRESET", "AUTO", "MANUAL", "FILTER"
 };
 
 static const char * const lookupTableRcInterpolationChannels[] = {
@@ -300,6 +301,15 @@ const clivalue_t valueTable[] = {
     { "gyro_notch1_cutoff",         VAR_UINT16 | MASTER_VALUE, .config.minmax = { 1, 16000 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_soft_notch_cutoff_1) },
     { "gyro_notch2_hz",             VAR_UINT16 | MASTER_VALUE, .config.minmax = { 0, 16000 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_soft_notch_hz_2) },
     { "gyro_notch2_cutoff",         VAR_UINT16 | MASTER_VALUE, .config.minmax = { 1, 16000 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_soft_notch_cutoff_2) },
+#ifdef USE_RPM_FILTER
+    { "gyro_rpm_notch_harmonics",   VAR_UINT8  | MASTER_VALUE, .config.minmax = { 0, 3 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_rpm_notch_harmonics) },
+    { "gyro_rpm_notch_min_hz",      VAR_UINT8  | MASTER_VALUE, .config.minmax = { 50, 200 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_rpm_notch_min_hz) },
+    { "gyro_rpm_notch_q",           VAR_UINT16 | MASTER_VALUE, .config.minmax = { 100, 3000 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_rpm_notch_q) },
+#endif
+#ifdef USE_GYRO_DATA_ANALYSE
+    { "dyn_fft_window",             VAR_UINT8  | MASTER_VALUE, .config.minmax = { 32, 128 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, dyn_fft_window) },
+    { "dyn_notch_count",            VAR_UINT8  | MASTER_VALUE, .config.minmax = { 1, DYN_NOTCH_COUNT_MAX }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, dyn_notch_count) },
+#endif
     { "moron_threshold",            VAR_UINT8  | MASTER_VALUE, .config.minmax = { 0,  200 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyroMovementCalibrationThreshold) },
 #if defined(GYRO_USES_SPI)
 #if defined(USE_GYRO_SPI_MPU6500) || defined(USE_GYRO_SPI_MPU9250) || defined(USE_GYRO_SPI_ICM20689)
@@ -337,6 +347,10 @@ const clivalue_t valueTable[] = {
     { "baro_noise_lpf",             VAR_UINT16  | MASTER_VALUE, .config.minmax = { 0, 1000 }, PG_BAROMETER_CONFIG, offsetof(barometerConfig_t, baro_noise_lpf) },
     { "baro_cf_vel",                VAR_UINT16  | MASTER_VALUE, .config.minmax = { 0, 1000 }, PG_BAROMETER_CONFIG, offsetof(barometerConfig_t, baro_cf_vel) },
     { "baro_cf_alt",                VAR_UINT16  | MASTER_VALUE, .config.minmax = { 0, 1000 }, PG_BAROMETER_CONFIG, offsetof(barometerConfig_t, baro_cf_alt) },
+    { "baro_kalman",                VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_BAROMETER_CONFIG, offsetof(barometerConfig_t, baro_kalman) },
+    { "baro_kf_acc_noise",          VAR_UINT16  | MASTER_VALUE, .config.minmax = { 1, 1000 }, PG_BAROMETER_CONFIG, offsetof(barometerConfig_t, baro_kf_acc_noise) },
+    { "baro_kf_baro_noise",         VAR_UINT16  | MASTER_VALUE, .config.minmax = { 1, 1000 }, PG_BAROMETER_CONFIG, offsetof(barometerConfig_t, baro_kf_baro_noise) },
+    { "baro_kf_range_noise",        VAR_UINT16  | MASTER_VALUE, .config.minmax = { 1, 1000 }, PG_BAROMETER_CONFIG, offsetof(barometerConfig_t, baro_kf_range_noise) },
 #endif
 
 // PG_RX_CONFIG
@@ -386,11 +400,15 @@ const clivalue_t valueTable[] = {
     { "min_command",                VAR_UINT16 | MASTER_VALUE, .config.minmax = { PWM_RANGE_ZERO, PWM_RANGE_MAX }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, mincommand) },
 #ifdef USE_DSHOT
     { "dshot_idle_value",           VAR_UINT16  | MASTER_VALUE, .config.minmax = { 0, 2000 }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, digitalIdleOffsetValue) },
+#endif
+#ifdef USE_DSHOT_TELEMETRY
+    { "dshot_bidir",                VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, dev.useDshotTelemetry) },
 #endif
     { "use_unsynced_pwm",           VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, dev.useUnsyncedPwm) },
     { "motor_pwm_protocol",         VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_MOTOR_PWM_PROTOCOL }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, dev.motorPwmProtocol) },
     { "motor_pwm_rate",             VAR_UINT16 | MASTER_VALUE, .config.minmax = { 200, 32000 }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, dev.motorPwmRate) },
     { "motor_pwm_inversion",        VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, dev.motorPwmInversion) },
+    { "motor_poles",                VAR_UINT8  | MASTER_VALUE, .config.minmax = { 4, 255 }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, motorPoleCount) },
 
 // PG_THROTTLE_CORRECTION_CONFIG
     { "thr_corr_value",             VAR_UINT8  | MASTER_VALUE, .config.minmax = { 0,  150 }, PG_THROTTLE_CORRECTION_CONFIG, offsetof(throttleCorrectionConfig_t, throttle_correction_value) },
@@ -488,6 +506,7 @@ const clivalue_t valueTable[] = {
     { "imu_dcm_kp",                 VAR_UINT16 | MASTER_VALUE, .config.minmax = { 0, 32000 }, PG_IMU_CONFIG, offsetof(imuConfig_t, dcm_kp) },
     { "imu_dcm_ki",                 VAR_UINT16 | MASTER_VALUE, .config.minmax = { 0, 32000 }, PG_IMU_CONFIG, offsetof(imuConfig_t, dcm_ki) },
     { "small_angle",                VAR_UINT8  | MASTER_VALUE, .config.minmax = { 0, 180 }, PG_IMU_CONFIG, offsetof(imuConfig_t, small_angle) },
+    { "imu_update_rate_hz",         VAR_UINT16 | MASTER_VALUE, .config.minmax = { 50, 8000 }, PG_IMU_CONFIG, offsetof(imuConfig_t, update_rate_hz) },
 
 // PG_ARMING_CONFIG
     { "auto_disarm_delay",          VAR_UINT8  | MASTER_VALUE, .config.minmax = { 0, 60 }, PG_ARMING_CONFIG, offsetof(armingConfig_t, auto_disarm_delay) },
@@ -538,6 +557,7 @@ const clivalue_t valueTable[] = {
     { "anti_gravity_gain",          VAR_UINT16 | PROFILE_VALUE, .config.minmax = { 1, 30000 }, PG_PID_PROFILE, offsetof(pidProfile_t, itermAcceleratorGain) },
     { "setpoint_relax_ratio",       VAR_UINT8  | PROFILE_VALUE, .config.minmax = { 0, 100 }, PG_PID_PROFILE, offsetof(pidProfile_t, setpointRelaxRatio) },
     { "dterm_setpoint_weight",      VAR_UINT8  | PROFILE_VALUE, .config.minmax = { 0, 254 }, PG_PID_PROFILE, offsetof(pidProfile_t, dtermSetpointWeight) },
+    { "feedforward",                VAR_UINT8  | PROFILE_VALUE, .config.minmax = { 0, 200 }, PG_PID_PROFILE, offsetof(pidProfile_t, feedForward) },
     { "acc_limit_yaw",              VAR_UINT16 | PROFILE_VALUE, .config.minmax = { 1, 500 }, PG_PID_PROFILE, offsetof(pidProfile_t, yawRateAccelLimit) },
     { "acc_limit",                  VAR_UINT16 | PROFILE_VALUE, .config.minmax = { 1, 500 }, PG_PID_PROFILE, offsetof(pidProfile_t, rateAccelLimit) },
     { "crash_dthreshold",           VAR_UINT16 | PROFILE_VALUE, .config.minmax = { 0, 2000 }, PG_PID_PROFILE, offsetof(pidProfile_t, crash_dthreshold) },
@@ -682,6 +702,7 @@ const clivalue_t valueTable[] = {
 #ifndef SKIP_TASK_STATISTICS
     { "task_statistics",            VAR_INT8   | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_SYSTEM_CONFIG, offsetof(systemConfig_t, task_statistics) },
 #endif
+    { "fast_boot",                  VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_SYSTEM_CONFIG, offsetof(systemConfig_t, fast_boot) },
     { "debug_mode",                 VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_DEBUG }, PG_SYSTEM_CONFIG, offsetof(systemConfig_t, debug_mode) },
 
 // PG_VTX_CONFIG
@@ -720,6 +741,76 @@ const clivalue_t valueTable[] = {
 
 const uint16_t valueTableEntryCount = ARRAYLEN(valueTable);
 
+// valueTable indices sorted by name, built on first lookup
+static uint16_t valueTableSortedIndex[ARRAYLEN(valueTable)];
+static bool valueTableSortedIndexBuilt = false;
+
+static void settingsBuildSortedIndex(void)
+{
+    // insertion sort, runs once and the table is mostly grouped by prefix already
+    for (unsigned i = 0; i < ARRAYLEN(valueTable); i++) {
+        unsigned j = i;
+        while (j > 0 && strcasecmp(valueTable[valueTableSortedIndex[j - 1]].name, valueTable[i].name) > 0) {
+            valueTableSortedIndex[j] = valueTableSortedIndex[j - 1];
+            j--;
+        }
+        valueTableSortedIndex[j] = i;
+    }
+    valueTableSortedIndexBuilt = true;
+}
+
+static int settingNameCompare(const char *name, uint8_t length, const char *settingName)
+{
+    const int result = strncasecmp(name, settingName, length);
+    if (result == 0 && settingName[length] != '\0') {
+        return -1; // name is a prefix of settingName, so it sorts first
+    }
+    return result;
+}
+
+// exact, case insensitive lookup of the first length characters of name
+const clivalue_t *settingFind(const char *name, uint8_t length)
+{
+    if (!valueTableSortedIndexBuilt) {
+        settingsBuildSortedIndex();
+    }
+
+    int low = 0;
+    int high = ARRAYLEN(valueTable) - 1;
+    while (low <= high) {
+        const int mid = (low + high) / 2;
+        const clivalue_t *value = &valueTable[valueTableSortedIndex[mid]];
+        const int result = settingNameCompare(name, length, value->name);
+        if (result == 0) {
+            return value;
+        } else if (result < 0) {
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+uint16_t settingGetValueOffset(const clivalue_t *value)
+{
+    switch (value->type & VALUE_SECTION_MASK) {
+    case MASTER_VALUE:
+        return value->offset;
+    case PROFILE_VALUE:
+        return value->offset + sizeof(pidProfile_t) * getCurrentPidProfileIndex();
+    case PROFILE_RATE_VALUE:
+        return value->offset + sizeof(controlRateConfig_t) * getCurrentControlRateProfileIndex();
+    }
+    return 0;
+}
+
+void *settingGetValuePointer(const clivalue_t *value)
+{
+    const pgRegistry_t* rec = pgFind(value->pgn);
+    return CONST_CAST(void *, rec->address + settingGetValueOffset(value));
+}
+
 void settingsBuildCheck() {
     BUILD_BUG_ON(LOOKUP_TABLE_COUNT != ARRAYLEN(lookupTables));
 }
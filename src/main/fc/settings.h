@@ -126,6 +126,10 @@ extern const lookupTableEntry_t lookupTables[];
 extern const uint16_t valueTableEntryCount;
 
 extern const clivalue_t valueTable[];
+
+const clivalue_t *settingFind(const char *name, uint8_t length);
+uint16_t settingGetValueOffset(const clivalue_t *value);
+void *settingGetValuePointer(const clivalue_t *value);
 //extern const uint8_t lookupTablesEntryCount;
 
 extern const char * const lookupTableAccHardware[];
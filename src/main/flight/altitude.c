@@ -45,6 +45,9 @@
 #include "sensors/sensors.h"
 #include "sensors/barometer.h"
 #include "sensors/sonar.h"
+#ifdef RADAR
+#include "sensors/radar.h"
+#endif
 
 
 int32_t AltHold;
@@ -52,7 +55,7 @@ static int32_t estimatedVario = 0;                      // variometer in cm/s
 static int32_t estimatedAltitude = 0;                // in cm
 
 
-#if defined(BARO) || defined(SONAR)
+#if defined(BARO) || defined(SONAR) || defined(RADAR)
 
 enum {
     DEBUG_ALTITUDE_ACC,
@@ -231,8 +234,170 @@ int32_t calculateAltHoldThrottleAdjustment(int32_t vel_tmp, float accZ_tmp, floa
     return result;
 }
 
+/*
+ * Kalman filter for altitude and vertical velocity.
+ * The state is predicted with the earth frame acceleration accumulated by the IMU on every call and corrected with
+ * baro and radar/sonar range measurements whenever a new sample is available. Measurements are compared against the
+ * state propagated back to their sample time, so the sensor latency is not folded into the estimate.
+ */
+typedef struct altitudeKalman_s {
+    float altitude;     // cm
+    float velocity;     // cm/s
+    float P[2][2];
+} altitudeKalman_t;
+
+static altitudeKalman_t altKf;
+
+static void altitudeKalmanReset(float altitude)
+{
+    altKf.altitude = altitude;
+    altKf.velocity = 0.0f;
+    altKf.P[0][0] = sq((float)barometerConfig()->baro_kf_baro_noise);
+    altKf.P[0][1] = 0.0f;
+    altKf.P[1][0] = 0.0f;
+    altKf.P[1][1] = sq(100.0f);
+}
+
+static void altitudeKalmanPredict(float dt, float accZ)
+{
+    altKf.altitude += (altKf.velocity + 0.5f * accZ * dt) * dt;
+    altKf.velocity += accZ * dt;
+
+    // P = F * P * F' + Q, with F = [1 dt; 0 1] and Q from a white acceleration noise
+    const float q = sq((float)barometerConfig()->baro_kf_acc_noise);
+    const float dt2 = dt * dt;
+    const float p01 = altKf.P[0][1] + dt * altKf.P[1][1];
+
+    altKf.P[0][0] += dt * (altKf.P[1][0] + p01) + q * dt2 * dt2 * 0.25f;
+    altKf.P[0][1] = p01 + q * dt2 * dt * 0.5f;
+    altKf.P[1][0] = altKf.P[0][1];
+    altKf.P[1][1] += q * dt2;
+}
+
+// measurementAgeUs is the time between the measurement sample and the current state
+static void altitudeKalmanCorrect(float measuredAltitude, float noise, timeDelta_t measurementAgeUs)
+{
+    const float age = constrainf(measurementAgeUs * 1e-6f, 0.0f, 0.1f);
+    const float innovation = measuredAltitude - (altKf.altitude - altKf.velocity * age);
+
+    const float s = altKf.P[0][0] + sq(noise);
+    const float k0 = altKf.P[0][0] / s;
+    const float k1 = altKf.P[1][0] / s;
+
+    altKf.altitude += k0 * innovation;
+    altKf.velocity += k1 * innovation;
+
+    const float p00 = altKf.P[0][0];
+    const float p01 = altKf.P[0][1];
+    altKf.P[0][0] -= k0 * p00;
+    altKf.P[0][1] -= k0 * p01;
+    altKf.P[1][0] -= k1 * p00;
+    altKf.P[1][1] -= k1 * p01;
+}
+
+static void calculateEstimatedAltitudeKalman(timeUs_t currentTimeUs)
+{
+    static timeUs_t previousTimeUs = 0;
+    static timeUs_t previousControlTimeUs = 0;
+    static bool initialised = false;
+    static float baroOffset = 0.0f;     // baro to range altitude difference while a range sensor is valid
+    static float accZ_old = 0.0f;
+
+    const float dt = (currentTimeUs - previousTimeUs) * 1e-6f;
+    previousTimeUs = currentTimeUs;
+
+#ifdef BARO
+    static timeUs_t lastBaroSampleTimeUs = 0;
+
+    if (sensors(SENSOR_BARO) && !isBaroCalibrationComplete()) {
+        performBaroCalibrationCycle();
+        imuResetAccelerationSum();
+        initialised = false;
+        return;
+    }
+#endif
+
+    if (!initialised) {
+        altitudeKalmanReset(estimatedAltitude);
+        baroOffset = 0.0f;
+        imuResetAccelerationSum();
+        initialised = true;
+        return;
+    }
+
+    float accZ_tmp = 0.0f;
+    if (sensors(SENSOR_ACC) && accSumCount) {
+        accZ_tmp = (float)accSum[Z] / accSumCount;
+    }
+    DEBUG_SET(DEBUG_ALTITUDE, DEBUG_ALTITUDE_ACC, accZ_tmp);
+    imuResetAccelerationSum();
+
+    // accVelScale converts acc units times microseconds into cm/s
+    altitudeKalmanPredict(dt, accZ_tmp * accVelScale * 1e6f);
+
+    float rangeAltitude = -1.0f;
+    timeUs_t rangeTimeUs = currentTimeUs;
+#ifdef RADAR
+    static timeUs_t lastRadarUpdateTimeUs = 0;
+
+    if (sensors(SENSOR_RADAR) && radar.radarUpdateTimeUs != lastRadarUpdateTimeUs) {
+        lastRadarUpdateTimeUs = radar.radarUpdateTimeUs;
+        const float cosTiltAngle = getCosTiltAngle();
+        // only use the range while the ground is inside the detection cone
+        if (radar.radarDistance > 0 && (int32_t)radar.radarDistance < radar.radarMaxRangeCm
+            && cosTiltAngle > cos_approx(DECIDEGREES_TO_RADIANS(radar.radarDetectionConeDecidegrees / 2))) {
+            rangeAltitude = radar.radarDistance * cosTiltAngle;
+            rangeTimeUs = radar.radarUpdateTimeUs;
+        }
+    }
+#endif
+#ifdef SONAR
+    if (rangeAltitude < 0 && sensors(SENSOR_SONAR)) {
+        const int32_t sonarAlt = sonarCalculateAltitude(sonarRead(), getCosTiltAngle());
+        if (sonarAlt > 0 && sonarAlt <= sonarMaxAltWithTiltCm) {
+            rangeAltitude = sonarAlt;
+        }
+    }
+#endif
+
+    if (rangeAltitude >= 0) {
+        altitudeKalmanCorrect(rangeAltitude, barometerConfig()->baro_kf_range_noise, cmpTimeUs(currentTimeUs, rangeTimeUs));
+    }
+
+#ifdef BARO
+    if (sensors(SENSOR_BARO) && baro.sampleTimeUs != lastBaroSampleTimeUs) {
+        lastBaroSampleTimeUs = baro.sampleTimeUs;
+        const float baroAlt = baroCalculateAltitude();
+        if (rangeAltitude >= 0) {
+            // follow the range sensor, so the baro does not pull the estimate away when leaving its range
+            baroOffset += 0.05f * ((rangeAltitude - baroAlt) - baroOffset);
+        }
+        altitudeKalmanCorrect(baroAlt + baroOffset, barometerConfig()->baro_kf_baro_noise, cmpTimeUs(currentTimeUs, baro.sampleTimeUs));
+    }
+#endif
+
+    estimatedAltitude = lrintf(altKf.altitude);
+    const int32_t vel_tmp = constrain(lrintf(altKf.velocity), -1500, 1500);
+    estimatedVario = applyDeadband(vel_tmp, 5);
+
+    DEBUG_SET(DEBUG_ALTITUDE, DEBUG_ALTITUDE_VEL, vel_tmp);
+    DEBUG_SET(DEBUG_ALTITUDE, DEBUG_ALTITUDE_HEIGHT, estimatedAltitude);
+
+    // the alt hold controller gains are tuned per iteration, so it keeps running at the 40hz rate
+    if (cmpTimeUs(currentTimeUs, previousControlTimeUs) >= BARO_UPDATE_FREQUENCY_40HZ) {
+        previousControlTimeUs = currentTimeUs;
+        altHoldThrottleAdjustment = calculateAltHoldThrottleAdjustment(vel_tmp, accZ_tmp, accZ_old);
+        accZ_old = accZ_tmp;
+    }
+}
+
 void calculateEstimatedAltitude(timeUs_t currentTimeUs)
 {
+    if (barometerConfig()->baro_kalman) {
+        calculateEstimatedAltitudeKalman(currentTimeUs);
+        return;
+    }
+
     static timeUs_t previousTimeUs = 0;
     const uint32_t dTime = currentTimeUs - previousTimeUs;
     if (dTime < BARO_UPDATE_FREQUENCY_40HZ)
@@ -334,7 +499,7 @@ void calculateEstimatedAltitude(timeUs_t currentTimeUs)
     altHoldThrottleAdjustment = calculateAltHoldThrottleAdjustment(vel_tmp, accZ_tmp, accZ_old);
     accZ_old = accZ_tmp;
 }
-#endif // defined(BARO) || defined(SONAR)
+#endif // defined(BARO) || defined(SONAR) || defined(RADAR)
 
 int32_t getEstimatedAltitude(void)
 {
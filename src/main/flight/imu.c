@@ -93,6 +93,7 @@ static imuRuntimeConfig_t imuRuntimeConfig;
 
 STATIC_UNIT_TESTED float q0 = 1.0f, q1 = 0.0f, q2 = 0.0f, q3 = 0.0f;    // quaternion of sensor frame relative to earth frame
 STATIC_UNIT_TESTED float rMat[3][3];
+static bool rMatValid = false;      // rMat is derived from the quaternion only when it is needed
 
 attitudeEulerAngles_t attitude = { { 0, 0, 0 } };     // absolute angle inclination in multiple of 0.1 degree    180 deg = 1800
 
@@ -103,7 +104,8 @@ PG_RESET_TEMPLATE(imuConfig_t, imuConfig,
     .dcm_ki = 0,                   // 0.003 * 10000
     .small_angle = 25,
     .accDeadband = {.xy = 40, .z= 40},
-    .acc_unarmedcal = 1
+    .acc_unarmedcal = 1,
+    .update_rate_hz = 100
 );
 
 STATIC_UNIT_TESTED void imuComputeRotationMatrix(void)
@@ -135,6 +137,15 @@ STATIC_UNIT_TESTED void imuComputeRotationMatrix(void)
     rMat[1][0] = -2.0f * (q1q2 - -q0q3);
     rMat[2][0] = -2.0f * (q1q3 + -q0q2);
 #endif
+
+    rMatValid = true;
+}
+
+static void imuUpdateRotationMatrix(void)
+{
+    if (!rMatValid) {
+        imuComputeRotationMatrix();
+    }
 }
 
 /*
@@ -210,6 +221,7 @@ static void imuCalculateAcceleration(uint32_t deltaT)
     accel_ned.V.Y = acc.accSmooth[Y];
     accel_ned.V.Z = acc.accSmooth[Z];
 
+    imuUpdateRotationMatrix();
     imuTransformVectorBodyToEarth(&accel_ned);
 
     if (imuRuntimeConfig.acc_unarmedcal == 1) {
@@ -277,6 +289,8 @@ static void imuMahonyAHRSupdate(float dt, float gx, float gy, float gz,
     float ex = 0, ey = 0;
     float recipNorm = sq(mx) + sq(my) + sq(mz);
     if (useMag && recipNorm > 0.01f) {
+        imuUpdateRotationMatrix();
+
         // Normalise magnetometer measurement
         recipNorm = invSqrt(recipNorm);
         mx *= recipNorm;
@@ -310,10 +324,19 @@ static void imuMahonyAHRSupdate(float dt, float gx, float gy, float gz,
         ay *= recipNorm;
         az *= recipNorm;
 
+        // Estimated direction of gravity in BF, equal to the last row of rMat
+#if defined(SIMULATOR_BUILD) && defined(SKIP_IMU_CALC) && !defined(SET_IMU_FROM_EULER)
+        const float vx = -2.0f * (q1 * q3 - q0 * q2);
+#else
+        const float vx = 2.0f * (q1 * q3 - q0 * q2);
+#endif
+        const float vy = 2.0f * (q2 * q3 + q0 * q1);
+        const float vz = 1.0f - 2.0f * (sq(q1) + sq(q2));
+
         // Error is sum of cross product between estimated direction and measured direction of gravity
-        ex += (ay * rMat[2][2] - az * rMat[2][1]);
-        ey += (az * rMat[2][0] - ax * rMat[2][2]);
-        ez += (ax * rMat[2][1] - ay * rMat[2][0]);
+        ex += (ay * vz - az * vy);
+        ey += (az * vx - ax * vz);
+        ez += (ax * vy - ay * vx);
     }
 
     // Compute and apply integral feedback if enabled
@@ -360,22 +383,33 @@ static void imuMahonyAHRSupdate(float dt, float gx, float gy, float gz,
     q2 *= recipNorm;
     q3 *= recipNorm;
 
-    // Pre-compute rotation matrix from quaternion
-    imuComputeRotationMatrix();
+    rMatValid = false;
 }
 
 STATIC_UNIT_TESTED void imuUpdateEulerAngles(void)
 {
+    // Only the rMat elements needed for the angles are calculated from the quaternion
+    const float r00 = 1.0f - 2.0f * (sq(q2) + sq(q3));
+#if defined(SIMULATOR_BUILD) && defined(SKIP_IMU_CALC) && !defined(SET_IMU_FROM_EULER)
+    const float r10 = -2.0f * (q1 * q2 + q0 * q3);
+    const float r20 = -2.0f * (q1 * q3 - q0 * q2);
+#else
+    const float r10 = 2.0f * (q1 * q2 + q0 * q3);
+    const float r20 = 2.0f * (q1 * q3 - q0 * q2);
+#endif
+    const float r21 = 2.0f * (q2 * q3 + q0 * q1);
+    const float r22 = 1.0f - 2.0f * (sq(q1) + sq(q2));
+
     /* Compute pitch/roll angles */
-    attitude.values.roll = lrintf(atan2f(rMat[2][1], rMat[2][2]) * (1800.0f / M_PIf));
-    attitude.values.pitch = lrintf(((0.5f * M_PIf) - acosf(-rMat[2][0])) * (1800.0f / M_PIf));
-    attitude.values.yaw = lrintf((-atan2f(rMat[1][0], rMat[0][0]) * (1800.0f / M_PIf) + magneticDeclination));
+    attitude.values.roll = lrintf(atan2f(r21, r22) * (1800.0f / M_PIf));
+    attitude.values.pitch = lrintf(((0.5f * M_PIf) - acosf(-r20)) * (1800.0f / M_PIf));
+    attitude.values.yaw = lrintf((-atan2f(r10, r00) * (1800.0f / M_PIf) + magneticDeclination));
 
     if (attitude.values.yaw < 0)
         attitude.values.yaw += 3600;
 
     /* Update small angle state */
-    if (rMat[2][2] > smallAngleCosZ) {
+    if (r22 > smallAngleCosZ) {
         ENABLE_STATE(SMALL_ANGLE);
     } else {
         DISABLE_STATE(SMALL_ANGLE);
@@ -447,7 +481,10 @@ static void imuCalculateEstimatedAttitude(timeUs_t currentTimeUs)
 
     imuUpdateEulerAngles();
 #endif
-    imuCalculateAcceleration(deltaT); // rotate acc vector into earth frame
+    // the earth frame acceleration is only consumed by the altitude estimation, fed by baro, sonar or radar
+    if (sensors(SENSOR_BARO) || sensors(SENSOR_SONAR) || sensors(SENSOR_RADAR)) {
+        imuCalculateAcceleration(deltaT); // rotate acc vector into earth frame
+    }
 }
 
 void imuUpdateAttitude(timeUs_t currentTimeUs)
@@ -472,7 +509,7 @@ void imuUpdateAttitude(timeUs_t currentTimeUs)
 
 float getCosTiltAngle(void)
 {
-    return rMat[2][2];
+    return 1.0f - 2.0f * (sq(q1) + sq(q2));
 }
 
 int16_t calculateThrottleAngleCorrection(uint8_t throttle_correction_value)
@@ -482,10 +519,11 @@ int16_t calculateThrottleAngleCorrection(uint8_t throttle_correction_value)
     * small angle < 0.86 deg
     * TODO: Define this small angle in config.
     */
-    if (rMat[2][2] <= 0.015f) {
+    const float cosTiltAngle = getCosTiltAngle();
+    if (cosTiltAngle <= 0.015f) {
         return 0;
     }
-    int angle = lrintf(acosf(rMat[2][2]) * throttleAngleScale);
+    int angle = lrintf(acosf(cosTiltAngle) * throttleAngleScale);
     if (angle > 900)
         angle = 900;
     return lrintf(throttle_correction_value * sin_approx(angle / (900.0f * M_PIf / 2.0f)));
@@ -52,6 +52,7 @@ typedef struct imuConfig_s {
     uint8_t small_angle;
     uint8_t acc_unarmedcal;                 // turn automatic acc compensation on/off
     accDeadband_t accDeadband;
+    uint16_t update_rate_hz;                // attitude estimation rate, up to the gyro loop rate
 } imuConfig_t;
 
 PG_DECLARE(imuConfig_t, imuConfig);
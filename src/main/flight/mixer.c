@@ -63,7 +63,7 @@ PG_RESET_TEMPLATE(mixerConfig_t, mixerConfig,
     .yaw_motors_reversed = false,
 );
 
-PG_REGISTER_WITH_RESET_FN(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 0);
+PG_REGISTER_WITH_RESET_FN(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 1);
 
 void pgResetFn_motorConfig(motorConfig_t *motorConfig)
 {
@@ -97,6 +97,10 @@ void pgResetFn_motorConfig(motorConfig_t *motorConfig)
     motorConfig->maxthrottle = 2000;
     motorConfig->mincommand = 1000;
     motorConfig->digitalIdleOffsetValue = 450;
+    motorConfig->motorPoleCount = 14;
+#ifdef USE_DSHOT_TELEMETRY
+    motorConfig->dev.useDshotTelemetry = false;
+#endif
 
     int motorIndex = 0;
 #ifdef USE_ONBOARD_ESC
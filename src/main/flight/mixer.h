@@ -112,6 +112,7 @@ typedef struct motorConfig_s {
     uint16_t minthrottle;                   // Set the minimum throttle command sent to the ESC (Electronic Speed Controller). This is the minimum value that allow motors to run at a idle speed.
     uint16_t maxthrottle;                   // This is the maximum value for the ESCs at full power this value can be increased up to 2000
     uint16_t mincommand;                    // This is the value for the ESCs when they are not armed. In some cases, this value must be lowered down to 900 for some specific ESCs
+    uint8_t motorPoleCount;                 // Number of magnetic poles in the motor bell, used to convert eRPM to RPM
 } motorConfig_t;
 
 PG_DECLARE(motorConfig_t, motorConfig);
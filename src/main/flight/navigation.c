@@ -306,8 +306,9 @@ void onGpsNewData(void)
     // Calculate time delta for navigation loop, range 0-1.0f, in seconds
     //
     // Time for calculating x,y speed and navigation pids
-    dTnav = (float)(millis() - nav_loopTimer) / 1000.0f;
-    nav_loopTimer = millis();
+    // measure between reception times, not parse times, so chunked reads don't add jitter
+    dTnav = (float)(gpsData.lastMessage - nav_loopTimer) / 1000.0f;
+    nav_loopTimer = gpsData.lastMessage;
     // prevent runup from bad GPS
     dTnav = MIN(dTnav, 1.0f);
 
@@ -101,6 +101,7 @@ void resetPidProfile(pidProfile_t *pidProfile)
         .levelSensitivity = 55,
         .setpointRelaxRatio = 100,
         .dtermSetpointWeight = 60,
+        .feedForward = 0,
         .yawRateAccelLimit = 100,
         .rateAccelLimit = 0,
         .itermThrottleThreshold = 350,
@@ -233,6 +234,7 @@ void pidInitFilters(const pidProfile_t *pidProfile)
 static float Kp[3], Ki[3], Kd[3], maxVelocity[3];
 static float relaxFactor;
 static float dtermSetpointWeight;
+static float feedForwardGain;
 static float levelGain, horizonGain, horizonTransition, horizonCutoffDegrees,
              horizonFactorRatio, ITermWindupPoint, ITermWindupPointInv;
 static uint8_t horizonTiltExpertMode;
@@ -250,6 +252,7 @@ void pidInitConfig(const pidProfile_t *pidProfile) {
     }
     dtermSetpointWeight = pidProfile->dtermSetpointWeight / 127.0f;
     relaxFactor = 1.0f / (pidProfile->setpointRelaxRatio / 100.0f);
+    feedForwardGain = FEEDFORWARD_SCALE * pidProfile->feedForward;
     levelGain = pidProfile->pid[PID_LEVEL].P / 10.0f;
     horizonGain = pidProfile->pid[PID_LEVEL].I / 10.0f;
     horizonTransition = (float)pidProfile->pid[PID_LEVEL].D;
@@ -371,6 +374,7 @@ static float accelerationLimit(int axis, float currentPidSetpoint) {
 void pidController(const pidProfile_t *pidProfile, const rollAndPitchTrims_t *angleTrim, timeUs_t currentTimeUs)
 {
     static float previousRateError[2];
+    static float previousSetpoint[3];
     const float tpaFactor = getThrottlePIDAttenuation();
     const float motorMixRange = getMotorMixRange();
     static bool inCrashRecoveryMode = false;
@@ -386,6 +390,10 @@ void pidController(const pidProfile_t *pidProfile, const rollAndPitchTrims_t *an
         if(maxVelocity[axis])
             currentPidSetpoint = accelerationLimit(axis, currentPidSetpoint);
 
+        // Stick setpoint rate of change, taken before any self-levelling replaces the setpoint
+        const float setpointDelta = currentPidSetpoint - previousSetpoint[axis];
+        previousSetpoint[axis] = currentPidSetpoint;
+
         // Yaw control is GYRO based, direct sticks control is applied to rate PID
         if ((FLIGHT_MODE(ANGLE_MODE) || FLIGHT_MODE(HORIZON_MODE)) && axis != YAW) {
             currentPidSetpoint = pidLevel(axis, pidProfile, angleTrim, currentPidSetpoint);
@@ -421,6 +429,12 @@ void pidController(const pidProfile_t *pidProfile, const rollAndPitchTrims_t *an
             axisPID_P[axis] = ptermYawFilterApplyFn(ptermYawFilter, axisPID_P[axis]);
         }
 
+        // -----add feed forward of the stick setpoint change, only when the sticks command rate directly
+        const bool setpointFromStick = axis == FD_YAW || !(FLIGHT_MODE(ANGLE_MODE) || FLIGHT_MODE(HORIZON_MODE));
+        if (feedForwardGain > 0 && !inCrashRecoveryMode && setpointFromStick) {
+            axisPID_P[axis] += feedForwardGain * (setpointDelta / dT) * tpaFactor;
+        }
+
         // -----calculate I component
         const float ITerm = axisPID_I[axis];
         const float ITermNew = ITerm + Ki[axis] * errorRate * dT * dynKi * itermAccelerator;
@@ -24,6 +24,7 @@
 
 #ifdef USE_MSP_DISPLAYPORT
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "config/parameter_group.h"
@@ -43,6 +44,21 @@ PG_REGISTER(displayPortProfile_t, displayPortProfileMsp, PG_DISPLAY_PORT_MSP_CON
 
 static displayPort_t mspDisplayPort;
 
+#define MSP_DISPLAYPORT_MAX_ROWS        16
+#define MSP_DISPLAYPORT_MAX_COLS        32
+#define MSP_OSD_MAX_STRING_LENGTH       30
+// $M> + size + command + checksum
+#define MSP_DISPLAYPORT_FRAME_OVERHEAD  6
+// unchanged cells bridged when merging two changed runs on a row
+#define MSP_DISPLAYPORT_RUN_MERGE_GAP   6
+
+// screenBuffer is what the OSD/CMS drew, shadowBuffer is what the remote display currently shows
+static uint8_t screenBuffer[MSP_DISPLAYPORT_MAX_ROWS * MSP_DISPLAYPORT_MAX_COLS];
+static uint8_t shadowBuffer[MSP_DISPLAYPORT_MAX_ROWS * MSP_DISPLAYPORT_MAX_COLS];
+static bool remoteInvalid = true;
+static bool drawPending = false;    // cells were sent but the draw frame committing them did not fit yet
+static uint16_t dirtyRows;          // one bit per row written since drawScreen last compared it
+
 #ifdef USE_CLI
 extern uint8_t cliMode;
 #endif
@@ -72,6 +88,8 @@ static int heartbeat(displayPort_t *displayPort)
 
 static int grab(displayPort_t *displayPort)
 {
+    // the remote screen content is unknown after a grab, so start from a cleared screen
+    remoteInvalid = true;
     return heartbeat(displayPort);
 }
 
@@ -79,20 +97,109 @@ static int release(displayPort_t *displayPort)
 {
     uint8_t subcmd[] = { 1 };
 
+    remoteInvalid = true;
     return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
 }
 
 static int clearScreen(displayPort_t *displayPort)
+{
+    // only the local screen buffer is cleared; cells that were blanked are sent by drawScreen
+    memset(screenBuffer, ' ', displayPort->rows * displayPort->cols);
+    dirtyRows = 0xFFFF;
+    return 0;
+}
+
+static int sendClearScreen(displayPort_t *displayPort)
 {
     uint8_t subcmd[] = { 2 };
 
     return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
 }
 
+static int sendString(displayPort_t *displayPort, uint8_t col, uint8_t row, const uint8_t *string, int len)
+{
+    uint8_t buf[MSP_OSD_MAX_STRING_LENGTH + 4];
+
+    buf[0] = 3;
+    buf[1] = row;
+    buf[2] = col;
+    buf[3] = 0;
+    memcpy(&buf[4], string, len);
+
+    return output(displayPort, MSP_DISPLAYPORT, buf, len + 4);
+}
+
+/*
+ * Sends the cells of the screen buffer that differ from what the remote display is known to show.
+ * Only rows written since they were last compared are scanned. Changed cells are grouped into runs per row;
+ * runs separated by only a few unchanged cells are merged, since resending those is cheaper than the header
+ * of another MSP frame.
+ * Stops when the MSP serial TX buffer is low, the remaining changes and the draw frame go out on the next call.
+ */
 static int drawScreen(displayPort_t *displayPort)
 {
-    uint8_t subcmd[] = { 4 };
-    return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
+    const uint8_t rows = displayPort->rows;
+    const uint8_t cols = displayPort->cols;
+
+    if (remoteInvalid) {
+        if (mspSerialTxBytesFree() < 1 + MSP_DISPLAYPORT_FRAME_OVERHEAD) {
+            return 0;
+        }
+        sendClearScreen(displayPort);
+        memset(shadowBuffer, ' ', sizeof(shadowBuffer));
+        remoteInvalid = false;
+        drawPending = true;
+        dirtyRows = 0xFFFF;
+    }
+
+    bool txBufferFull = false;
+    for (uint8_t row = 0; row < rows && !txBufferFull; row++) {
+        if (!(dirtyRows & (1 << row))) {
+            continue;
+        }
+
+        uint8_t *screenRow = &screenBuffer[row * cols];
+        uint8_t *shadowRow = &shadowBuffer[row * cols];
+
+        uint8_t col = 0;
+        while (col < cols) {
+            if (screenRow[col] == shadowRow[col]) {
+                col++;
+                continue;
+            }
+
+            // extend the run while changed cells follow within the merge distance
+            uint8_t runEnd = col + 1;
+            for (uint8_t next = runEnd; next < cols && next - col < MSP_OSD_MAX_STRING_LENGTH; next++) {
+                if (screenRow[next] != shadowRow[next]) {
+                    runEnd = next + 1;
+                } else if (next - runEnd >= MSP_DISPLAYPORT_RUN_MERGE_GAP) {
+                    break;
+                }
+            }
+
+            const int len = runEnd - col;
+            if (mspSerialTxBytesFree() < (uint32_t)(len + 4 + MSP_DISPLAYPORT_FRAME_OVERHEAD)) {
+                txBufferFull = true;
+                break;
+            }
+            sendString(displayPort, col, row, &screenRow[col], len);
+            memcpy(&shadowRow[col], &screenRow[col], len);
+            drawPending = true;
+            col = runEnd;
+        }
+
+        if (!txBufferFull) {
+            dirtyRows &= ~(1 << row);
+        }
+    }
+
+    if (drawPending && mspSerialTxBytesFree() >= 1 + MSP_DISPLAYPORT_FRAME_OVERHEAD) {
+        drawPending = false;
+        uint8_t subcmd[] = { 4 };
+        return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
+    }
+    return 0;
 }
 
 static int screenSize(const displayPort_t *displayPort)
@@ -102,30 +209,27 @@ static int screenSize(const displayPort_t *displayPort)
 
 static int write(displayPort_t *displayPort, uint8_t col, uint8_t row, const char *string)
 {
-#define MSP_OSD_MAX_STRING_LENGTH 30 // FIXME move this
-    uint8_t buf[MSP_OSD_MAX_STRING_LENGTH + 4];
-
-    int len = strlen(string);
-    if (len >= MSP_OSD_MAX_STRING_LENGTH) {
-        len = MSP_OSD_MAX_STRING_LENGTH;
+    if (row >= displayPort->rows || col >= displayPort->cols) {
+        return 0;
     }
 
-    buf[0] = 3;
-    buf[1] = row;
-    buf[2] = col;
-    buf[3] = 0;
-    memcpy(&buf[4], string, len);
+    dirtyRows |= 1 << row;
+    uint8_t *cell = &screenBuffer[row * displayPort->cols + col];
+    for (const uint8_t *end = cell + displayPort->cols - col; *string && cell < end; ) {
+        *cell++ = *string++;
+    }
 
-    return output(displayPort, MSP_DISPLAYPORT, buf, len + 4);
+    return 0;
 }
 
 static int writeChar(displayPort_t *displayPort, uint8_t col, uint8_t row, uint8_t c)
 {
-    char buf[2];
+    if (row < displayPort->rows && col < displayPort->cols) {
+        screenBuffer[row * displayPort->cols + col] = c;
+        dirtyRows |= 1 << row;
+    }
 
-    buf[0] = c;
-    buf[1] = 0;
-    return write(displayPort, col, row, buf); //!!TODO - check if there is a direct MSP command to do this
+    return 0;
 }
 
 static bool isTransferInProgress(const displayPort_t *displayPort)
@@ -134,10 +238,25 @@ static bool isTransferInProgress(const displayPort_t *displayPort)
     return false;
 }
 
+static void updateScreenSize(displayPort_t *displayPort)
+{
+    const uint8_t rows = constrain(13 + displayPortProfileMsp()->rowAdjust, 1, MSP_DISPLAYPORT_MAX_ROWS); // XXX Will reflect NTSC/PAL in the future
+    const uint8_t cols = constrain(30 + displayPortProfileMsp()->colAdjust, 1, MSP_DISPLAYPORT_MAX_COLS);
+
+    if (rows != displayPort->rows || cols != displayPort->cols) {
+        displayPort->rows = rows;
+        displayPort->cols = cols;
+        clearScreen(displayPort);
+    }
+}
+
 static void resync(displayPort_t *displayPort)
 {
-    displayPort->rows = 13 + displayPortProfileMsp()->rowAdjust; // XXX Will reflect NTSC/PAL in the future
-    displayPort->cols = 30 + displayPortProfileMsp()->colAdjust;
+    updateScreenSize(displayPort);
+
+    // resend the whole screen buffer
+    remoteInvalid = true;
+    drawScreen(displayPort);
 }
 
 static uint32_t txBytesFree(const displayPort_t *displayPort)
@@ -163,7 +282,7 @@ static const displayPortVTable_t mspDisplayPortVTable = {
 displayPort_t *displayPortMspInit(void)
 {
     displayInit(&mspDisplayPort, &mspDisplayPortVTable);
-    resync(&mspDisplayPort);
+    updateScreenSize(&mspDisplayPort);
     return &mspDisplayPort;
 }
 #endif // USE_MSP_DISPLAYPORT
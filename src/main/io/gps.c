@@ -63,6 +63,7 @@
 #define LOG_UBLOX_SVINFO 'I'
 #define LOG_UBLOX_POSLLH 'P'
 #define LOG_UBLOX_VELNED 'V'
+#define LOG_UBLOX_PVT    'T'
 
 #define GPS_SV_MAXSATS   16
 
@@ -156,10 +157,26 @@ static const uint8_t ubloxInit[] = {
     //0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x30, 0x01, 0x3C, 0xA3,           // set SVINFO MSG rate (every cycle - high bandwidth)
     0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x30, 0x05, 0x40, 0xA7,           // set SVINFO MSG rate (evey 5 cycles - low bandwidth)
     0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x12, 0x01, 0x1E, 0x67,           // set VELNED MSG rate
+    0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x07, 0x01, 0x13, 0x51,           // set PVT MSG rate, u-blox 6 does not know it and keeps the messages above
 
     0xB5, 0x62, 0x06, 0x08, 0x06, 0x00, 0xC8, 0x00, 0x01, 0x00, 0x01, 0x00, 0xDE, 0x6A,             // set rate to 5Hz (measurement period: 200ms, navigation rate: 1 cycle)
 };
 
+// Sent once the receiver has answered with NAV-PVT (u-blox 7 and newer). A receiver that rejects
+// 10Hz stays at the 5Hz set by ubloxInit.
+static const uint8_t ubloxPvtInit[] = {
+    // Disable the legacy navigation messages, NAV-PVT carries all of them in one frame
+    0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x02, 0x00, 0x0D, 0x46,           // disable POSLLH
+    0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x48,           // disable STATUS
+    0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x06, 0x00, 0x11, 0x4E,           // disable SOL
+    0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x12, 0x00, 0x1D, 0x66,           // disable VELNED
+
+    0xB5, 0x62, 0x06, 0x08, 0x06, 0x00, 0x64, 0x00, 0x01, 0x00, 0x01, 0x00, 0x7A, 0x12,             // set rate to 10Hz (measurement period: 100ms, navigation rate: 1 cycle)
+};
+
+static bool ubloxPvtReceived;           // the receiver sends NAV-PVT, the legacy messages are ignored
+static uint8_t ubloxPvtInitPosition;    // bytes of ubloxPvtInit sent so far
+
 // UBlox 6 Protocol documentation - GPS.G6-SW-10018-F
 // SBAS Configuration Settings Desciption, Page 4/210
 // 31.21 CFG-SBAS (0x06 0x16), Page 142/210
@@ -219,8 +236,10 @@ static void shiftPacketLog(void)
 }
 
 static void gpsNewData(uint16_t c);
+static void gpsNewDataSpan(const uint8_t *data, uint16_t len);
 static bool gpsNewFrameNMEA(char c);
 static bool gpsNewFrameUBLOX(uint8_t data);
+static uint16_t gpsNewFrameUBLOXSpan(const uint8_t *data, uint16_t len, bool *parsed);
 
 static void gpsSetState(gpsState_e state)
 {
@@ -374,6 +393,9 @@ void gpsInitUblox(void)
             }
 
             if (gpsData.messageState == GPS_MESSAGE_STATE_IDLE) {
+                // a re-initialised receiver starts over on the legacy messages
+                ubloxPvtReceived = false;
+                ubloxPvtInitPosition = 0;
                 gpsData.messageState++;
             }
 
@@ -408,6 +430,16 @@ void gpsInitUblox(void)
     }
 }
 
+// Moves a receiver that answered with NAV-PVT over to it, one byte per call like the init above
+static void gpsSwitchUbloxToPvt(void)
+{
+    if (!isSerialTransmitBufferEmpty(gpsPort))
+        return;
+
+    serialWrite(gpsPort, ubloxPvtInit[ubloxPvtInitPosition]);
+    ubloxPvtInitPosition++;
+}
+
 void gpsInitHardware(void)
 {
     switch (gpsConfig()->provider) {
@@ -430,12 +462,24 @@ static void updateGpsIndicator(timeUs_t currentTimeUs)
     }
 }
 
+// GPS bytes are pulled from the port in chunks of this size and parsed as a span
+#define GPS_RX_CHUNK_SIZE 64
+
 void gpsUpdate(timeUs_t currentTimeUs)
 {
-    // read out available GPS bytes
+    // read out available GPS bytes, frames completed now are stamped with this reception time
     if (gpsPort) {
-        while (serialRxBytesWaiting(gpsPort))
-            gpsNewData(serialRead(gpsPort));
+        uint8_t rxChunk[GPS_RX_CHUNK_SIZE];
+        uint32_t available;
+
+        gpsData.rxTime = currentTimeUs / 1000;
+        while ((available = serialRxBytesWaiting(gpsPort)) > 0) {
+            const uint16_t len = MIN(available, sizeof(rxChunk));
+            for (uint16_t i = 0; i < len; i++) {
+                rxChunk[i] = serialRead(gpsPort);
+            }
+            gpsNewDataSpan(rxChunk, len);
+        }
     }
 
     switch (gpsData.state) {
@@ -468,6 +512,10 @@ void gpsUpdate(timeUs_t currentTimeUs)
                 // remove GPS from capability
                 sensorsClear(SENSOR_GPS);
                 gpsSetState(GPS_LOST_COMMUNICATION);
+                break;
+            }
+            if (ubloxPvtReceived && ubloxPvtInitPosition < sizeof(ubloxPvtInit) && gpsConfig()->autoConfig == GPS_AUTOCONFIG_ON) {
+                gpsSwitchUbloxToPvt();
             }
             break;
     }
@@ -476,15 +524,11 @@ void gpsUpdate(timeUs_t currentTimeUs)
     }
 }
 
-static void gpsNewData(uint16_t c)
+static void gpsHandleNewFrame(void)
 {
-    if (!gpsNewFrame(c)) {
-        return;
-    }
-
     // new data received and parsed, we're in business
     gpsData.lastLastMessage = gpsData.lastMessage;
-    gpsData.lastMessage = millis();
+    gpsData.lastMessage = gpsData.rxTime;
     sensorsSet(SENSOR_GPS);
 
     if (GPS_update == 1)
@@ -499,6 +543,42 @@ static void gpsNewData(uint16_t c)
     onGpsNewData();
 }
 
+static void gpsNewData(uint16_t c)
+{
+    gpsData.rxTime = millis();
+    if (gpsNewFrame(c)) {
+        gpsHandleNewFrame();
+    }
+}
+
+static void gpsNewDataSpan(const uint8_t *data, uint16_t len)
+{
+    while (len > 0) {
+        bool parsed = false;
+        uint16_t consumed = 0;
+
+        switch (gpsConfig()->provider) {
+        case GPS_NMEA:
+            while (consumed < len && !parsed) {
+                parsed = gpsNewFrameNMEA(data[consumed++]);
+            }
+            break;
+        case GPS_UBLOX:
+            consumed = gpsNewFrameUBLOXSpan(data, len, &parsed);
+            break;
+        default:
+            return;
+        }
+
+        data += consumed;
+        len -= consumed;
+
+        if (parsed) {
+            gpsHandleNewFrame();
+        }
+    }
+}
+
 bool gpsNewFrame(uint8_t c)
 {
     switch (gpsConfig()->provider) {
@@ -573,8 +653,11 @@ static uint32_t GPS_coord_to_degrees(char *coordinateString)
 }
 */
 
+// NMEA field buffer, one byte is kept for the terminator
+#define NMEA_FIELD_SIZE 15
+
 // helper functions
-static uint32_t grab_fields(char *src, uint8_t mult)
+static uint32_t grab_fields(const char *src, uint8_t mult)
 {                               // convert string to uint32
     uint32_t i;
     uint32_t tmp = 0;
@@ -583,13 +666,18 @@ static uint32_t grab_fields(char *src, uint8_t mult)
             i++;
             if (mult == 0)
                 break;
-            else
-                src[i + mult] = 0;
+            // take exactly mult fractional digits, short fractions are padded with zeros
+            for (uint8_t digit = 0; digit < mult; digit++) {
+                tmp *= 10;
+                if (src[i] >= '0' && src[i] <= '9')
+                    tmp += src[i++] - '0';
+            }
+            break;
         }
         tmp *= 10;
         if (src[i] >= '0' && src[i] <= '9')
             tmp += src[i] - '0';
-        if (i >= 15)
+        if (i >= NMEA_FIELD_SIZE - 1)
             return 0; // out of bounds
     }
     return tmp;
@@ -610,7 +698,7 @@ static bool gpsNewFrameNMEA(char c)
 
     uint8_t frameOK = 0;
     static uint8_t param = 0, offset = 0, parity = 0;
-    static char string[15];
+    static char string[NMEA_FIELD_SIZE];
     static uint8_t checksum_param, gps_frame = NO_FRAME;
     static uint8_t svMessageNum = 0;
     uint8_t svSatNum = 0, svPacketIdx = 0, svSatParam = 0;
@@ -699,7 +787,8 @@ static bool gpsNewFrameNMEA(char c)
                     svSatNum    = svPacketIdx + (4 * (svMessageNum - 1)); // global satellite number
                     svSatParam  = param - 3 - (4 * (svPacketIdx - 1)); // parameter number for satellite
 
-                    if(svSatNum > GPS_SV_MAXSATS)
+                    // a missing or bogus message number must not index outside the sv tables
+                    if(svSatNum == 0 || svSatNum > GPS_SV_MAXSATS)
                         break;
 
                     switch(svSatParam) {
@@ -765,7 +854,7 @@ static bool gpsNewFrameNMEA(char c)
             checksum_param = 0;
             break;
         default:
-            if (offset < 15)
+            if (offset < NMEA_FIELD_SIZE - 1)
                 string[offset++] = c;
             if (!checksum_param)
                 parity ^= c;
@@ -834,6 +923,41 @@ typedef struct {
     uint32_t heading_accuracy;
 } ubx_nav_velned;
 
+typedef struct {
+    uint32_t time;              // GPS msToW
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t min;
+    uint8_t sec;
+    uint8_t valid;
+    uint32_t time_accuracy;
+    int32_t time_nsec;
+    uint8_t fix_type;
+    uint8_t fix_status;
+    uint8_t flags2;
+    uint8_t satellites;
+    int32_t longitude;
+    int32_t latitude;
+    int32_t altitude_ellipsoid;
+    int32_t altitude_msl;
+    uint32_t horizontal_accuracy;
+    uint32_t vertical_accuracy;
+    int32_t ned_north;          // mm/s
+    int32_t ned_east;
+    int32_t ned_down;
+    int32_t speed_2d;           // mm/s
+    int32_t heading_2d;         // deg * 100000
+    uint32_t speed_accuracy;
+    uint32_t heading_accuracy;
+    uint16_t position_DOP;
+    uint8_t reserved[6];
+    int32_t heading_vehicle;
+    int16_t magnetic_declination;
+    uint16_t magnetic_accuracy;
+} ubx_nav_pvt;
+
 typedef struct {
     uint8_t chn;                // Channel number, 255 for SVx not assigned to channel
     uint8_t svid;               // Satellite ID
@@ -864,6 +988,7 @@ enum {
     MSG_POSLLH = 0x2,
     MSG_STATUS = 0x3,
     MSG_SOL = 0x6,
+    MSG_PVT = 0x7,
     MSG_VELNED = 0x12,
     MSG_SVINFO = 0x30,
     MSG_CFG_PRT = 0x00,
@@ -928,6 +1053,7 @@ static union {
     ubx_nav_status status;
     ubx_nav_solution solution;
     ubx_nav_velned velned;
+    ubx_nav_pvt pvt;
     ubx_nav_svinfo svinfo;
     uint8_t bytes[UBLOX_PAYLOAD_SIZE];
 } _buffer;
@@ -948,6 +1074,11 @@ static bool UBLOX_parse_gps(void)
 
     *gpsPacketLogChar = LOG_IGNORED;
 
+    // legacy messages still sent after the switch to NAV-PVT would report the same epoch twice
+    if (ubloxPvtReceived && (_msg_id == MSG_POSLLH || _msg_id == MSG_STATUS || _msg_id == MSG_SOL || _msg_id == MSG_VELNED)) {
+        return false;
+    }
+
     switch (_msg_id) {
     case MSG_POSLLH:
         *gpsPacketLogChar = LOG_UBLOX_POSLLH;
@@ -983,11 +1114,36 @@ static bool UBLOX_parse_gps(void)
         GPS_ground_course = (uint16_t) (_buffer.velned.heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
         _new_speed = true;
         break;
+    case MSG_PVT:
+        *gpsPacketLogChar = LOG_UBLOX_PVT;
+        ubloxPvtReceived = true;
+        next_fix = (_buffer.pvt.fix_status & NAV_STATUS_FIX_VALID) && (_buffer.pvt.fix_type == FIX_3D);
+        if (next_fix) {
+            ENABLE_STATE(GPS_FIX);
+        } else {
+            DISABLE_STATE(GPS_FIX);
+        }
+        GPS_coord[LON] = _buffer.pvt.longitude;
+        GPS_coord[LAT] = _buffer.pvt.latitude;
+        GPS_altitude = _buffer.pvt.altitude_msl / 10 / 100;  //alt in m
+        GPS_numSat = _buffer.pvt.satellites;
+        GPS_hdop = _buffer.pvt.position_DOP;
+        GPS_speed = _buffer.pvt.speed_2d / 10;    // mm/s to cm/s
+        GPS_ground_course = (uint16_t) (_buffer.pvt.heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
+        // position and speed of the same epoch arrive together
+        _new_position = _new_speed = true;
+        break;
     case MSG_SVINFO:
         *gpsPacketLogChar = LOG_UBLOX_SVINFO;
         GPS_numCh = _buffer.svinfo.numCh;
         if (GPS_numCh > 16)
             GPS_numCh = 16;
+        // don't report channels beyond the received payload, they hold data of an older message
+        if (_payload_length < 8) {
+            GPS_numCh = 0;
+        } else if (GPS_numCh > (_payload_length - 8) / 12) {
+            GPS_numCh = (_payload_length - 8) / 12;
+        }
         for (i = 0; i < GPS_numCh; i++){
             GPS_svinfo_chn[i]= _buffer.svinfo.channel[i].chn;
             GPS_svinfo_svid[i]= _buffer.svinfo.channel[i].svid;
@@ -1095,6 +1251,52 @@ static bool gpsNewFrameUBLOX(uint8_t data)
     return parsed;
 }
 
+// Feeds a span of received bytes to the UBX state machine. Sync search and payload copy run over
+// the whole span, only the frame header and checksum go through the per byte states. Returns the
+// number of bytes consumed, which stops right after a frame that produced a new solution.
+static uint16_t gpsNewFrameUBLOXSpan(const uint8_t *data, uint16_t len, bool *parsed)
+{
+    const uint8_t *p = data;
+    const uint8_t *end = data + len;
+
+    *parsed = false;
+
+    while (p < end) {
+        if (_step == 0) {
+            const uint8_t *sync = memchr(p, PREAMBLE1, end - p);
+            if (!sync) {
+                return len;
+            }
+            p = sync;
+        } else if (_step == 6) {
+            const uint16_t count = MIN(_payload_length - _payload_counter, end - p);
+            if (_payload_counter < UBLOX_PAYLOAD_SIZE) {
+                memcpy(&_buffer.bytes[_payload_counter], p, MIN(count, UBLOX_PAYLOAD_SIZE - _payload_counter));
+            }
+            uint8_t ck_a = _ck_a;
+            uint8_t ck_b = _ck_b;
+            for (uint16_t i = 0; i < count; i++) {
+                ck_b += (ck_a += p[i]);
+            }
+            _ck_a = ck_a;
+            _ck_b = ck_b;
+            _payload_counter += count;
+            p += count;
+            if (_payload_counter >= _payload_length) {
+                _step++;
+            }
+            continue;
+        }
+
+        if (gpsNewFrameUBLOX(*p++)) {
+            *parsed = true;
+            break;
+        }
+    }
+
+    return p - data;
+}
+
 static void gpsHandlePassthrough(uint8_t data)
  {
      gpsNewData(data);
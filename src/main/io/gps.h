@@ -92,6 +92,7 @@ typedef struct gpsData_s {
     uint32_t timeouts;
     uint32_t lastMessage;           // last time valid GPS data was received (millis)
     uint32_t lastLastMessage;       // last-last valid GPS message. Used to calculate delta.
+    uint32_t rxTime;                // reception time of the bytes being parsed (millis)
 
     uint32_t state_position;        // incremental variable for loops
     uint32_t state_ts;              // timestamp for last state_position increment
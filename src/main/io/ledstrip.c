@@ -183,7 +183,25 @@ void pgResetFn_ledStripConfig(ledStripConfig_t *ledStripConfig)
 static int scaledThrottle;
 static int auxInput;
 
+// per led values derived from the led configuration, updated by reevaluateLedConfig()
+static uint8_t ledQuadrants[LED_MAX_STRIP_LENGTH];
+static int8_t ledFirstDirection[LED_MAX_STRIP_LENGTH];
+
+// inputs of the fixed layers, the cached colors are recalculated only when one of them changes
+typedef struct fixedLayerInputs_s {
+    uint16_t flightModeFlags;
+    uint8_t armingFlags;
+    uint8_t batteryPercentage;
+    uint16_t rssi;
+    int16_t auxInput;
+} fixedLayerInputs_t;
+
+static fixedLayerInputs_t fixedLayerInputs;
+static hsvColor_t fixedLayerColors[LED_MAX_STRIP_LENGTH];
+static bool fixedLayerColorsValid = false;
+
 static void updateLedRingCounts(void);
+static void updateLedQuadrants(void);
 
 STATIC_UNIT_TESTED void updateDimensions(void)
 {
@@ -251,6 +269,8 @@ void reevaluateLedConfig(void)
     updateLedCount();
     updateDimensions();
     updateLedRingCounts();
+    updateLedQuadrants();
+    fixedLayerColorsValid = false;
 }
 
 // get specialColor by index
@@ -389,38 +409,51 @@ typedef enum {
     QUADRANT_WEST       = 1 << 3,
 } quadrant_e;
 
+static void updateLedQuadrants(void)
+{
+    for (int ledIndex = 0; ledIndex < ledCounts.count; ledIndex++) {
+        const ledConfig_t *ledConfig = &ledStripConfig()->ledConfigs[ledIndex];
+
+        int x = ledGetX(ledConfig);
+        int y = ledGetY(ledConfig);
+
+        int quad = 0;
+        if (y <= highestYValueForNorth)
+            quad |= QUADRANT_NORTH;
+        else if (y >= lowestYValueForSouth)
+            quad |= QUADRANT_SOUTH;
+        if (x >= lowestXValueForEast)
+            quad |= QUADRANT_EAST;
+        else if (x <= highestXValueForWest)
+            quad |= QUADRANT_WEST;
+
+        ledQuadrants[ledIndex] = quad;
+
+        const int ledDirection = ledGetDirection(ledConfig);
+        ledFirstDirection[ledIndex] = -1;
+        for (unsigned i = 0; i < LED_DIRECTION_COUNT; i++) {
+            if (ledDirection & (1 << i)) {
+                ledFirstDirection[ledIndex] = i;
+                break;
+            }
+        }
+    }
+}
+
 static quadrant_e getLedQuadrant(const int ledIndex)
 {
-    const ledConfig_t *ledConfig = &ledStripConfig()->ledConfigs[ledIndex];
-
-    int x = ledGetX(ledConfig);
-    int y = ledGetY(ledConfig);
-
-    int quad = 0;
-    if (y <= highestYValueForNorth)
-        quad |= QUADRANT_NORTH;
-    else if (y >= lowestYValueForSouth)
-        quad |= QUADRANT_SOUTH;
-    if (x >= lowestXValueForEast)
-        quad |= QUADRANT_EAST;
-    else if (x <= highestXValueForWest)
-        quad |= QUADRANT_WEST;
-
-    return quad;
+    return ledQuadrants[ledIndex];
 }
 
 static hsvColor_t* getDirectionalModeColor(const int ledIndex, const modeColorIndexes_t *modeColors)
 {
-    const ledConfig_t *ledConfig = &ledStripConfig()->ledConfigs[ledIndex];
-    const int ledDirection = ledGetDirection(ledConfig);
+    const int direction = ledFirstDirection[ledIndex];
 
-    for (unsigned i = 0; i < LED_DIRECTION_COUNT; i++) {
-        if (ledDirection & (1 << i)) {
-            return &ledStripConfigMutable()->colors[modeColors->color[i]];
-        }
+    if (direction < 0) {
+        return NULL;
     }
 
-    return NULL;
+    return &ledStripConfigMutable()->colors[modeColors->color[direction]];
 }
 
 // map flight mode to led mode, in order of priority
@@ -441,7 +474,7 @@ static const struct {
     {0,             LED_MODE_ORIENTATION},
 };
 
-static void applyLedFixedLayers()
+static void updateFixedLayerColors(void)
 {
     for (int ledIndex = 0; ledIndex < ledCounts.count; ledIndex++) {
         const ledConfig_t *ledConfig = &ledStripConfig()->ledConfigs[ledIndex];
@@ -477,12 +510,12 @@ static void applyLedFixedLayers()
 
             case LED_FUNCTION_BATTERY:
                 color = HSV(RED);
-                hOffset += scaleRange(calculateBatteryPercentageRemaining(), 0, 100, -30, 120);
+                hOffset += scaleRange(fixedLayerInputs.batteryPercentage, 0, 100, -30, 120);
                 break;
 
             case LED_FUNCTION_RSSI:
                 color = HSV(RED);
-                hOffset += scaleRange(rssi * 100, 0, 1023, -30, 120);
+                hOffset += scaleRange(fixedLayerInputs.rssi * 100, 0, 1023, -30, 120);
                 break;
 
             default:
@@ -506,7 +539,33 @@ static void applyLedFixedLayers()
                 }
        }
         color.h = (color.h + hOffset) % (HSV_HUE_MAX + 1);
-        setLedHsv(ledIndex, &color);
+        fixedLayerColors[ledIndex] = color;
+    }
+}
+
+static void applyLedFixedLayers()
+{
+    const fixedLayerInputs_t inputs = {
+        .flightModeFlags = flightModeFlags,
+        .armingFlags = armingFlags,
+        .batteryPercentage = calculateBatteryPercentageRemaining(),
+        .rssi = rssi,
+        .auxInput = auxInput,
+    };
+
+    if (!fixedLayerColorsValid
+        || inputs.flightModeFlags != fixedLayerInputs.flightModeFlags
+        || inputs.armingFlags != fixedLayerInputs.armingFlags
+        || inputs.batteryPercentage != fixedLayerInputs.batteryPercentage
+        || inputs.rssi != fixedLayerInputs.rssi
+        || inputs.auxInput != fixedLayerInputs.auxInput) {
+        fixedLayerInputs = inputs;
+        updateFixedLayerColors();
+        fixedLayerColorsValid = true;
+    }
+
+    for (int ledIndex = 0; ledIndex < ledCounts.count; ledIndex++) {
+        setLedHsv(ledIndex, &fixedLayerColors[ledIndex]);
     }
 }
 
@@ -1116,6 +1175,8 @@ bool parseColor(int index, const char *colorConfig)
         memset(color, 0, sizeof(*color));
     }
 
+    fixedLayerColorsValid = false;
+
     return result;
 }
 
@@ -1142,6 +1203,7 @@ bool setModeColor(ledModeIndex_e modeIndex, int modeColorIndex, int colorIndex)
     } else {
         return false;
     }
+    fixedLayerColorsValid = false;
     return true;
 }
 
@@ -132,6 +132,37 @@ static uint8_t armState;
 
 static displayPort_t *osdDisplayPort;
 
+// Element cells
+
+// Every element records the cells it draws; a refresh only erases and redraws the elements whose cells changed
+// since the previous refresh instead of clearing and redrawing the whole screen.
+#define OSD_CELL_POOL_SIZE 512
+
+typedef struct osdCell_s {
+    uint8_t x;
+    uint8_t y;
+    uint8_t c;
+} osdCell_t;
+
+typedef struct osdElementCells_s {
+    osdCell_t cells[OSD_CELL_POOL_SIZE];
+    uint16_t start[OSD_ITEM_COUNT];
+    uint8_t count[OSD_ITEM_COUNT];
+} osdElementCells_t;
+
+static osdElementCells_t osdElementCells[2];
+static uint8_t osdCellFrame;                    // osdElementCells entry recorded by the current refresh
+static uint16_t osdCellCount;
+static bool osdCellOverflow;
+static uint8_t osdDrawOrder[OSD_ITEM_COUNT];
+static uint8_t osdDrawOrderCount;
+static bool osdElementsInvalid = true;          // screen content is unknown, redraw everything from a cleared screen
+
+// cells erased or drawn during the current refresh, one bit per OSD_POS()
+static uint32_t osdTouchedCells[(OSD_POS_MAX + 1 + 31) / 32];
+#define SET_TOUCHED(pos) (osdTouchedCells[(pos) / 32] |= (1 << ((pos) % 32)))
+#define IS_TOUCHED(pos) (osdTouchedCells[(pos) / 32] & (1 << ((pos) % 32)))
+
 
 #define AH_MAX_PITCH 200 // Specify maximum AHI pitch value displayed. Default 200 = 20.0 degrees
 #define AH_MAX_ROLL 400  // Specify maximum AHI roll value displayed. Default 400 = 40.0 degrees
@@ -231,7 +262,31 @@ static uint8_t osdGetDirectionSymbolFromHeading(int heading)
     return SYM_ARROW_SOUTH + heading;
 }
 
-static void osdDrawSingleElement(uint8_t item)
+static void osdWriteChar(uint8_t x, uint8_t y, uint8_t c)
+{
+    if (x > OSD_X(OSD_POS_MAX) || y > OSD_Y(OSD_POS_MAX)) {
+        return;
+    }
+
+    if (osdCellCount >= OSD_CELL_POOL_SIZE) {
+        osdCellOverflow = true;
+        return;
+    }
+
+    osdCell_t *cell = &osdElementCells[osdCellFrame].cells[osdCellCount++];
+    cell->x = x;
+    cell->y = y;
+    cell->c = c;
+}
+
+static void osdWrite(uint8_t x, uint8_t y, const char *s)
+{
+    while (*s) {
+        osdWriteChar(x++, y, *s++);
+    }
+}
+
+static void osdDrawElementCells(uint8_t item)
 {
     if (!VISIBLE(osdConfig()->item_pos[item]) || BLINK(item)) {
         return;
@@ -387,7 +442,7 @@ static void osdDrawSingleElement(uint8_t item)
             else if (FLIGHT_MODE(HORIZON_MODE))
                 p = "HOR";
 
-            displayWrite(osdDisplayPort, elemPosX, elemPosY, p);
+            osdWrite(elemPosX, elemPosY, p);
             return;
         }
 
@@ -457,11 +512,11 @@ static void osdDrawSingleElement(uint8_t item)
                 y -= pitchAngle;
                 // y += 41; // == 4 * 9 + 5
                 if (y >= 0 && y <= 81) {
-                    displayWriteChar(osdDisplayPort, elemPosX + x, elemPosY + (y / 9), (SYM_AH_BAR9_0 + (y % 9)));
+                    osdWriteChar(elemPosX + x, elemPosY + (y / 9), (SYM_AH_BAR9_0 + (y % 9)));
                 }
             }
 
-            osdDrawSingleElement(OSD_HORIZON_SIDEBARS);
+            osdDrawElementCells(OSD_HORIZON_SIDEBARS);
 
             return;
         }
@@ -479,13 +534,13 @@ static void osdDrawSingleElement(uint8_t item)
             const int8_t hudwidth = AH_SIDEBAR_WIDTH_POS;
             const int8_t hudheight = AH_SIDEBAR_HEIGHT_POS;
             for (int y = -hudheight; y <= hudheight; y++) {
-                displayWriteChar(osdDisplayPort, elemPosX - hudwidth, elemPosY + y, SYM_AH_DECORATION);
-                displayWriteChar(osdDisplayPort, elemPosX + hudwidth, elemPosY + y, SYM_AH_DECORATION);
+                osdWriteChar(elemPosX - hudwidth, elemPosY + y, SYM_AH_DECORATION);
+                osdWriteChar(elemPosX + hudwidth, elemPosY + y, SYM_AH_DECORATION);
             }
 
             // AH level indicators
-            displayWriteChar(osdDisplayPort, elemPosX - hudwidth + 1, elemPosY, SYM_AH_LEFT);
-            displayWriteChar(osdDisplayPort, elemPosX + hudwidth - 1, elemPosY, SYM_AH_RIGHT);
+            osdWriteChar(elemPosX - hudwidth + 1, elemPosY, SYM_AH_LEFT);
+            osdWriteChar(elemPosX + hudwidth - 1, elemPosY, SYM_AH_RIGHT);
 
             return;
         }
@@ -625,16 +680,97 @@ static void osdDrawSingleElement(uint8_t item)
         return;
     }
 
-    displayWrite(osdDisplayPort, elemPosX + elemOffsetX, elemPosY, buff);
+    osdWrite(elemPosX + elemOffsetX, elemPosY, buff);
 }
 
-void osdDrawElements(void)
+static void osdDrawSingleElement(uint8_t item)
 {
-    displayClearScreen(osdDisplayPort);
+    osdElementCells_t *frame = &osdElementCells[osdCellFrame];
+
+    frame->start[item] = osdCellCount;
+    osdDrawElementCells(item);
+    frame->count[item] = osdCellCount - frame->start[item];
+
+    if (osdDrawOrderCount < OSD_ITEM_COUNT) {
+        osdDrawOrder[osdDrawOrderCount++] = item;
+    }
+}
 
+static void osdDrawCells(const osdCell_t *cells, int count)
+{
+    for (int i = 0; i < count; i++) {
+        displayWriteChar(osdDisplayPort, cells[i].x, cells[i].y, cells[i].c);
+        SET_TOUCHED(OSD_POS(cells[i].x, cells[i].y));
+    }
+}
+
+/*
+ * Erase the cells of every element whose output differs from the previous refresh, then draw in element order
+ * the changed elements and any unchanged element with a cell that was erased or drawn over on the way, so
+ * overlapping elements end up as if the whole screen had been redrawn.
+ */
+static void osdUpdateElementCells(void)
+{
+    const osdElementCells_t *now = &osdElementCells[osdCellFrame];
+    const osdElementCells_t *last = &osdElementCells[osdCellFrame ^ 1];
+
+    if (osdElementsInvalid || osdCellOverflow) {
+        displayClearScreen(osdDisplayPort);
+        for (int i = 0; i < osdDrawOrderCount; i++) {
+            const uint8_t item = osdDrawOrder[i];
+            osdDrawCells(&now->cells[now->start[item]], now->count[item]);
+        }
+        // a truncated recording can't be compared against, so draw everything again next time
+        osdElementsInvalid = osdCellOverflow;
+        return;
+    }
+
+    bool changed[OSD_ITEM_COUNT];
+    memset(osdTouchedCells, 0, sizeof(osdTouchedCells));
+
+    for (int item = 0; item < OSD_ITEM_COUNT; item++) {
+        const osdCell_t *lastCells = &last->cells[last->start[item]];
+
+        changed[item] = now->count[item] != last->count[item]
+            || memcmp(&now->cells[now->start[item]], lastCells, now->count[item] * sizeof(osdCell_t)) != 0;
+
+        if (changed[item]) {
+            for (int i = 0; i < last->count[item]; i++) {
+                displayWriteChar(osdDisplayPort, lastCells[i].x, lastCells[i].y, ' ');
+                SET_TOUCHED(OSD_POS(lastCells[i].x, lastCells[i].y));
+            }
+        }
+    }
+
+    for (int i = 0; i < osdDrawOrderCount; i++) {
+        const uint8_t item = osdDrawOrder[i];
+        const osdCell_t *cells = &now->cells[now->start[item]];
+        bool draw = changed[item];
+
+        for (int j = 0; j < now->count[item] && !draw; j++) {
+            draw = IS_TOUCHED(OSD_POS(cells[j].x, cells[j].y));
+        }
+
+        if (draw) {
+            osdDrawCells(cells, now->count[item]);
+        }
+    }
+}
+
+void osdDrawElements(void)
+{
     /* Hide OSD when OSDSW mode is active */
-    if (IS_RC_MODE_ACTIVE(BOXOSD))
-      return;
+    if (IS_RC_MODE_ACTIVE(BOXOSD)) {
+        displayClearScreen(osdDisplayPort);
+        osdElementsInvalid = true;
+        return;
+    }
+
+    osdCellFrame ^= 1;
+    osdCellCount = 0;
+    osdCellOverflow = false;
+    osdDrawOrderCount = 0;
+    memset(osdElementCells[osdCellFrame].count, 0, sizeof(osdElementCells[osdCellFrame].count));
 
 #if 0
     if (currentElement)
@@ -703,6 +839,8 @@ void osdDrawElements(void)
       osdDrawSingleElement(OSD_ESC_RPM);
   }
 #endif
+
+    osdUpdateElementCells();
 }
 
 void pgResetFn_osdConfig(osdConfig_t *osdConfig)
@@ -795,6 +933,7 @@ void osdInit(displayPort_t *osdDisplayPortToUse)
     memset(blinkBits, 0, sizeof(blinkBits));
 
     displayClearScreen(osdDisplayPort);
+    osdElementsInvalid = true;
 
     osdDrawLogo(3, 1);
 
@@ -968,6 +1107,7 @@ static void osdShowStats(void)
     char buff[10];
 
     displayClearScreen(osdDisplayPort);
+    osdElementsInvalid = true;
     displayWrite(osdDisplayPort, 2, top++, "  --- STATS ---");
 
     if (osdConfig()->enabled_stats[OSD_STAT_ARMEDTIME]) {
@@ -1039,6 +1179,7 @@ static void osdShowStats(void)
 static void osdShowArmed(void)
 {
     displayClearScreen(osdDisplayPort);
+    osdElementsInvalid = true;
     displayWrite(osdDisplayPort, 12, 7, "ARMED");
 }
 
@@ -1099,8 +1240,10 @@ static void osdRefresh(timeUs_t currentTimeUs)
         osdUpdateAlarms();
         osdDrawElements();
         displayHeartbeat(osdDisplayPort);
-#ifdef OSD_CALLS_CMS
     } else {
+        // the CMS owns the screen, the elements are redrawn from a cleared screen once it is released
+        osdElementsInvalid = true;
+#ifdef OSD_CALLS_CMS
         cmsUpdate(currentTimeUs);
 #endif
     }
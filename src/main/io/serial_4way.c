@@ -24,6 +24,8 @@
 
 #ifdef  USE_SERIAL_4WAY_BLHELI_INTERFACE
 
+#include "common/maths.h"
+
 #include "drivers/buf_writer.h"
 #include "drivers/io.h"
 #include "drivers/serial.h"
@@ -292,51 +294,6 @@ void esc4wayRelease(void)
 #define ACK_I_INVALID_PARAM     0x09
 #define ACK_D_GENERAL_ERROR     0x0F
 
-/* Copyright (c) 2002, 2003, 2004  Marek Michalkiewicz
-   Copyright (c) 2005, 2007 Joerg Wunsch
-   Copyright (c) 2013 Dave Hylands
-   Copyright (c) 2013 Frederic Nadeau
-   All rights reserved.
-
-   Redistribution and use in source and binary forms, with or without
-   modification, are permitted provided that the following conditions are met:
-
-   * Redistributions of source code must retain the above copyright
-     notice, this list of conditions and the following disclaimer.
-
-   * Redistributions in binary form must reproduce the above copyright
-     notice, this list of conditions and the following disclaimer in
-     the documentation and/or other materials provided with the
-     distribution.
-
-   * Neither the name of the copyright holders nor the names of
-     contributors may be used to endorse or promote products derived
-     from this software without specific prior written permission.
-
-  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
-  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
-  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
-  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
-  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
-  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
-  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
-  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
-  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
-  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
-  POSSIBILITY OF SUCH DAMAGE. */
-uint16_t _crc_xmodem_update (uint16_t crc, uint8_t data) {
-        int i;
-
-        crc = crc ^ ((uint16_t)data << 8);
-        for (i=0; i < 8; i++){
-            if (crc & 0x8000)
-                crc = (crc << 1) ^ 0x1021;
-            else
-                crc <<= 1;
-        }
-        return crc;
-}
-// * End copyright
 
 
 #define ATMEL_DEVICE_MATCH ((pDeviceInfo->words[0] == 0x9307) || (pDeviceInfo->words[0] == 0x930A) || \
@@ -398,6 +355,12 @@ static uint8_t Connect(uint8_32_u *pDeviceInfo)
 
 static serialPort_t *port;
 
+// escape, command, address high, address low, parameter length
+#define FRAME_HEADER_SIZE   5
+// parameter length 0 stands for 256 bytes
+#define FRAME_PARAM_MAX     256
+#define FRAME_PARAM_LEN(len) ((len) ? (len) : FRAME_PARAM_MAX)
+
 static uint8_t ReadByte(void)
 {
     // need timeout?
@@ -405,39 +368,31 @@ static uint8_t ReadByte(void)
     return serialRead(port);
 }
 
-static uint8_16_u CRC_in;
-static uint8_t ReadByteCrc(void)
+// Drains everything the receive buffer holds before polling it again
+static void ReadBuf(uint8_t *buf, uint16_t len)
 {
-    uint8_t b = ReadByte();
-    CRC_in.word = _crc_xmodem_update(CRC_in.word, b);
-    return b;
-}
-
-static void WriteByte(uint8_t b)
-{
-    serialWrite(port, b);
+    while (len > 0) {
+        for (uint32_t available = serialRxBytesWaiting(port); available > 0 && len > 0; available--, len--) {
+            *buf++ = serialRead(port);
+        }
+    }
 }
 
-static uint8_16_u CRCout;
-static void WriteByteCrc(uint8_t b)
-{
-    WriteByte(b);
-    CRCout.word = _crc_xmodem_update(CRCout.word, b);
-}
+// Reply frame: header, parameters, ack and CRC, sent with a single serialWriteBuf()
+static uint8_t txFrame[FRAME_HEADER_SIZE + FRAME_PARAM_MAX + 3];
 
 void esc4wayProcess(serialPort_t *mspPort)
 {
 
-    uint8_t ParamBuf[256];
-    uint8_t ESC;
+    uint8_t ParamBuf[FRAME_PARAM_MAX];
+    uint8_t Header[FRAME_HEADER_SIZE];
     uint8_t I_PARAM_LEN;
     uint8_t CMD;
     uint8_t ACK_OUT;
-    uint8_16_u CRC_check;
+    uint8_t CRC_in[2];
     uint8_16_u Dummy;
     uint8_t O_PARAM_LEN;
     uint8_t *O_PARAM;
-    uint8_t *InBuff;
     ioMem_t ioMem;
 
     port = mspPort;
@@ -453,32 +408,27 @@ void esc4wayProcess(serialPort_t *mspPort)
     while(1) {
         // restart looking for new sequence from host
         do {
-            CRC_in.word = 0;
-            ESC = ReadByteCrc();
-        } while (ESC != cmd_Local_Escape);
+            Header[0] = ReadByte();
+        } while (Header[0] != cmd_Local_Escape);
 
         RX_LED_ON;
 
         Dummy.word = 0;
         O_PARAM = &Dummy.bytes[0];
         O_PARAM_LEN = 1;
-        CMD = ReadByteCrc();
-        ioMem.D_FLASH_ADDR_H = ReadByteCrc();
-        ioMem.D_FLASH_ADDR_L = ReadByteCrc();
-        I_PARAM_LEN = ReadByteCrc();
+        ReadBuf(&Header[1], FRAME_HEADER_SIZE - 1);
+        CMD = Header[1];
+        ioMem.D_FLASH_ADDR_H = Header[2];
+        ioMem.D_FLASH_ADDR_L = Header[3];
+        I_PARAM_LEN = Header[4];
 
-        InBuff = ParamBuf;
-        uint8_t i = I_PARAM_LEN;
-        do {
-          *InBuff = ReadByteCrc();
-          InBuff++;
-          i--;
-        } while (i != 0);
+        ReadBuf(ParamBuf, FRAME_PARAM_LEN(I_PARAM_LEN));
+        ReadBuf(CRC_in, sizeof(CRC_in));
 
-        CRC_check.bytes[1] = ReadByte();
-        CRC_check.bytes[0] = ReadByte();
+        uint16_t crc = crc16_ccitt_update(0, Header, FRAME_HEADER_SIZE);
+        crc = crc16_ccitt_update(crc, ParamBuf, FRAME_PARAM_LEN(I_PARAM_LEN));
 
-        if(CRC_check.word == CRC_in.word) {
+        if (crc == ((CRC_in[0] << 8) | CRC_in[1])) {
             ACK_OUT = ACK_OK;
         } else {
             ACK_OUT = ACK_I_INVALID_CRC;
@@ -875,29 +825,23 @@ void esc4wayProcess(serialPort_t *mspPort)
             }
         }
 
-        CRCout.word = 0;
-
         RX_LED_OFF;
 
-        serialBeginWrite(port);
-        WriteByteCrc(cmd_Remote_Escape);
-        WriteByteCrc(CMD);
-        WriteByteCrc(ioMem.D_FLASH_ADDR_H);
-        WriteByteCrc(ioMem.D_FLASH_ADDR_L);
-        WriteByteCrc(O_PARAM_LEN);
+        uint8_t *txPtr = txFrame;
+        *txPtr++ = cmd_Remote_Escape;
+        *txPtr++ = CMD;
+        *txPtr++ = ioMem.D_FLASH_ADDR_H;
+        *txPtr++ = ioMem.D_FLASH_ADDR_L;
+        *txPtr++ = O_PARAM_LEN;
+        memcpy(txPtr, O_PARAM, FRAME_PARAM_LEN(O_PARAM_LEN));
+        txPtr += FRAME_PARAM_LEN(O_PARAM_LEN);
+        *txPtr++ = ACK_OUT;
+        crc = crc16_ccitt_update(0, txFrame, txPtr - txFrame);
+        *txPtr++ = crc >> 8;
+        *txPtr++ = crc & 0xFF;
 
-        i=O_PARAM_LEN;
-        do {
-            while (!serialTxBytesFree(port));
-
-            WriteByteCrc(*O_PARAM);
-            O_PARAM++;
-            i--;
-        } while (i > 0);
-
-        WriteByteCrc(ACK_OUT);
-        WriteByte(CRCout.bytes[1]);
-        WriteByte(CRCout.bytes[0]);
+        serialBeginWrite(port);
+        serialWriteBuf(port, txFrame, txPtr - txFrame);
         serialEndWrite(port);
 
         TX_LED_OFF;
@@ -263,6 +263,8 @@
 #define MSP_MOTOR_CONFIG         131    //out message         Motor configuration (min/max throttle, etc)
 #define MSP_GPS_CONFIG           132    //out message         GPS configuration
 #define MSP_COMPASS_CONFIG       133    //out message         Compass configuration
+#define MSP_SETTING              134    //out message         Value and range of the setting named in the payload
+#define MSP_MOTOR_TELEMETRY      139    //out message         Per-motor rpm measured by the ESC
 
 #define MSP_SET_RAW_RC           200    //in message          8 rc chan
 #define MSP_SET_RAW_GPS          201    //in message          fix, numsat, lat, lon, alt, speed
@@ -289,6 +291,7 @@
 #define MSP_SET_MOTOR_CONFIG     222    //out message         Motor configuration (min/max throttle, etc)
 #define MSP_SET_GPS_CONFIG       223    //out message         GPS configuration
 #define MSP_SET_COMPASS_CONFIG   224    //out message         Compass configuration
+#define MSP_SET_SETTING          225    //in message          Set a setting by name
 
 // #define MSP_BIND                 240    //in message          no param
 // #define MSP_ALARMS               242
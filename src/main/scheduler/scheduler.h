@@ -77,7 +77,7 @@ typedef enum {
 #ifdef RADAR
     TASK_RADAR,
 #endif
-#if defined(BARO) || defined(SONAR)
+#if defined(BARO) || defined(SONAR) || defined(RADAR)
     TASK_ALTITUDE,
 #endif
 #ifdef USE_DASHBOARD
@@ -32,6 +32,7 @@
 #include "drivers/barometer/barometer_fake.h"
 #include "drivers/barometer/barometer_ms5611.h"
 #include "drivers/barometer/barometer_dps310.h"
+#include "drivers/time.h"
 
 
 #include "fc/runtime_config.h"
@@ -52,7 +53,11 @@ PG_RESET_TEMPLATE(barometerConfig_t, barometerConfig,
     .baro_sample_count = 20,
     .baro_noise_lpf = 600,
     .baro_cf_vel = 968,
-    .baro_cf_alt = 987
+    .baro_cf_alt = 987,
+    .baro_kalman = 0,
+    .baro_kf_acc_noise = 50,
+    .baro_kf_baro_noise = 50,
+    .baro_kf_range_noise = 5
 );
 
 #ifdef BARO
@@ -211,11 +216,12 @@ bool isBaroReady(void) {
 uint32_t baroUpdate(void)
 {
 #ifdef USE_BARO_DPS310_BACKGROUND
-	baro.dev.get_ut();
+	// the sensor measures continuously, get_up collects the results queued since the last call
 	baro.dev.get_up();
 	baro.dev.calculate(&baroPressure, &baroTemperature);
 	baroPressureSum = recalculateBarometerTotal(barometerConfig()->baro_sample_count, baroPressureSum, baroPressure);
-	return 0;
+	baro.sampleTimeUs = micros();
+	return baro.dev.up_delay;
 
 #else
     static barometerState_e state = BAROMETER_NEEDS_SAMPLES;
@@ -234,6 +240,7 @@ uint32_t baroUpdate(void)
             baro.dev.start_ut();
             baro.dev.calculate(&baroPressure, &baroTemperature);
             baroPressureSum = recalculateBarometerTotal(barometerConfig()->baro_sample_count, baroPressureSum, baroPressure);
+            baro.sampleTimeUs = micros();
             state = BAROMETER_NEEDS_SAMPLES;
             return baro.dev.ut_delay;
         break;
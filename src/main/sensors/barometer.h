@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "common/time.h"
 #include "config/parameter_group.h"
 #include "drivers/barometer/barometer.h"
 
@@ -37,6 +38,10 @@ typedef struct barometerConfig_s {
     uint16_t baro_noise_lpf;                // additional LPF to reduce baro noise
     uint16_t baro_cf_vel;                   // apply Complimentary Filter to keep the calculated velocity based on baro velocity (i.e. near real velocity)
     uint16_t baro_cf_alt;                   // apply CF to use ACC for height estimation
+    uint8_t baro_kalman;                    // use the kalman filter instead of the CF for altitude and vario estimation
+    uint16_t baro_kf_acc_noise;             // kalman process noise of the earth frame acceleration, cm/s^2
+    uint16_t baro_kf_baro_noise;            // kalman measurement noise of the baro altitude, cm
+    uint16_t baro_kf_range_noise;           // kalman measurement noise of radar/sonar ranges, cm
 } barometerConfig_t;
 
 PG_DECLARE(barometerConfig_t, barometerConfig);
@@ -45,6 +50,7 @@ typedef struct baro_s {
     baroDev_t dev;
     int32_t BaroAlt;
     int32_t baroTemperature;             // Use temperature for telemetry
+    timeUs_t sampleTimeUs;               // time of the last pressure sample
 } baro_t;
 
 extern baro_t baro;
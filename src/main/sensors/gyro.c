@@ -51,9 +51,12 @@
 #include "drivers/bus_spi.h"
 #include "drivers/gyro_sync.h"
 #include "drivers/io.h"
+#include "drivers/pwm_output.h"
 
 #include "fc/runtime_config.h"
 
+#include "flight/mixer.h"
+
 #include "io/beeper.h"
 #include "io/statusindicator.h"
 
@@ -70,6 +73,11 @@
 
 gyro_t gyro;
 
+#ifdef USE_RPM_FILTER
+#define RPM_FILTER_MOTOR_COUNT      4
+#define RPM_FILTER_HARMONICS_MAX    3
+#define RPM_FILTER_FADE_RANGE_HZ    50  // a notch fades in over this range above gyro_rpm_notch_min_hz
+#endif
 
 typedef struct gyroCalibration_s {
     int32_t sum[XYZ_AXIS_COUNT];
@@ -96,7 +104,15 @@ typedef struct gyroSensor_s {
     filterApplyFnPtr notchFilter2ApplyFn;
     biquadFilter_t notchFilter2[XYZ_AXIS_COUNT];
     filterApplyFnPtr notchFilterDynApplyFn;
-    biquadFilter_t notchFilterDyn[XYZ_AXIS_COUNT];
+    biquadFilter_t notchFilterDyn[DYN_NOTCH_COUNT_MAX][XYZ_AXIS_COUNT];
+#ifdef USE_RPM_FILTER
+    // motor rpm tracking notch filters
+    uint8_t rpmNotchMotorCount;
+    uint8_t rpmNotchHarmonics;
+    uint8_t rpmNotchUpdateIndex;
+    biquadFilter_t rpmNotchFilter[RPM_FILTER_MOTOR_COUNT][RPM_FILTER_HARMONICS_MAX][XYZ_AXIS_COUNT];
+    float rpmNotchWeight[RPM_FILTER_MOTOR_COUNT][RPM_FILTER_HARMONICS_MAX];   // 0 bypasses the notch
+#endif
 } gyroSensor_t;
 
 static gyroSensor_t gyroSensor0;
@@ -128,7 +144,16 @@ PG_RESET_TEMPLATE(gyroConfig_t, gyroConfig,
     .gyro_soft_notch_hz_1 = 400,
     .gyro_soft_notch_cutoff_1 = 300,
     .gyro_soft_notch_hz_2 = 200,
-    .gyro_soft_notch_cutoff_2 = 100
+    .gyro_soft_notch_cutoff_2 = 100,
+#ifdef USE_RPM_FILTER
+    .gyro_rpm_notch_harmonics = 2,
+    .gyro_rpm_notch_min_hz = 100,
+    .gyro_rpm_notch_q = 500,
+#endif
+#ifdef USE_GYRO_DATA_ANALYSE
+    .dyn_fft_window = 32,
+    .dyn_notch_count = 1,
+#endif
 );
 
 
@@ -441,17 +466,105 @@ void gyroInitFilterDynamicNotch(gyroSensor_t *gyroSensor)
 {
     gyroSensor->notchFilterDynApplyFn = (filterApplyFnPtr)biquadFilterApplyDF1; // must be this function, not DF2
     const float notchQ = filterGetNotchQ(400, 390); //just any init value
-    for (int axis = 0; axis < 3; axis++) {
-        biquadFilterInit(&gyroSensor->notchFilterDyn[axis], 400, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+    for (int notch = 0; notch < DYN_NOTCH_COUNT_MAX; notch++) {
+        for (int axis = 0; axis < 3; axis++) {
+            biquadFilterInit(&gyroSensor->notchFilterDyn[notch][axis], 400, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+        }
+    }
+}
+
+#ifdef USE_RPM_FILTER
+static void gyroInitFilterRpmNotch(gyroSensor_t *gyroSensor)
+{
+    // without a motor speed source there is nothing to track
+    if (!isMotorErpmAvailable()) {
+        gyroSensor->rpmNotchMotorCount = 0;
+        gyroSensor->rpmNotchHarmonics = 0;
+        return;
+    }
+
+    gyroSensor->rpmNotchMotorCount = MIN(getMotorCount(), RPM_FILTER_MOTOR_COUNT);
+    gyroSensor->rpmNotchHarmonics = MIN(gyroConfig()->gyro_rpm_notch_harmonics, RPM_FILTER_HARMONICS_MAX);
+    gyroSensor->rpmNotchUpdateIndex = 0;
+
+    const float notchQ = gyroConfig()->gyro_rpm_notch_q / 100.0f;
+    for (int motor = 0; motor < gyroSensor->rpmNotchMotorCount; motor++) {
+        for (int harmonic = 0; harmonic < gyroSensor->rpmNotchHarmonics; harmonic++) {
+            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                biquadFilterInit(&gyroSensor->rpmNotchFilter[motor][harmonic][axis], gyroConfig()->gyro_rpm_notch_min_hz, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+            }
+            // bypassed until the motor speed is known
+            gyroSensor->rpmNotchWeight[motor][harmonic] = 0.0f;
+        }
     }
 }
 
+/*
+ * Retune the notches of one motor per call, so the coefficient cost per gyro cycle stays fixed.
+ * All axes share the same coefficients, so they are only calculated once.
+ * A harmonic below gyro_rpm_notch_min_hz (which includes a stopped motor or an unknown speed) or above
+ * the usable gyro bandwidth is bypassed, and fades in over RPM_FILTER_FADE_RANGE_HZ above the minimum.
+ */
+static void gyroUpdateRpmNotch(gyroSensor_t *gyroSensor)
+{
+    const uint8_t motor = gyroSensor->rpmNotchUpdateIndex;
+    if (++gyroSensor->rpmNotchUpdateIndex >= gyroSensor->rpmNotchMotorCount) {
+        gyroSensor->rpmNotchUpdateIndex = 0;
+    }
+
+    const uint32_t erpm = getMotorErpm(motor);
+    DEBUG_SET(DEBUG_ESC_SENSOR_RPM, motor, erpm / 100);
+
+    const float motorHz = erpm / (30.0f * motorConfig()->motorPoleCount);
+    const float minHz = gyroConfig()->gyro_rpm_notch_min_hz;
+    const float maxHz = 0.48f * 1000000.0f / gyro.targetLooptime;
+    const float notchQ = gyroConfig()->gyro_rpm_notch_q / 100.0f;
+
+    for (int harmonic = 0; harmonic < gyroSensor->rpmNotchHarmonics; harmonic++) {
+        biquadFilter_t *notch = gyroSensor->rpmNotchFilter[motor][harmonic];
+        const float notchHz = motorHz * (harmonic + 1);
+
+        if (notchHz < minHz || notchHz > maxHz) {
+            gyroSensor->rpmNotchWeight[motor][harmonic] = 0.0f;
+            continue;
+        }
+        gyroSensor->rpmNotchWeight[motor][harmonic] = constrainf((notchHz - minHz) / RPM_FILTER_FADE_RANGE_HZ, 0.0f, 1.0f);
+
+        biquadFilterUpdate(&notch[X], notchHz, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+        for (int axis = Y; axis < XYZ_AXIS_COUNT; axis++) {
+            notch[axis].b0 = notch[X].b0;
+            notch[axis].b1 = notch[X].b1;
+            notch[axis].b2 = notch[X].b2;
+            notch[axis].a1 = notch[X].a1;
+            notch[axis].a2 = notch[X].a2;
+        }
+    }
+}
+
+static float gyroApplyRpmNotch(gyroSensor_t *gyroSensor, int axis, float value)
+{
+    for (int motor = 0; motor < gyroSensor->rpmNotchMotorCount; motor++) {
+        for (int harmonic = 0; harmonic < gyroSensor->rpmNotchHarmonics; harmonic++) {
+            const float weight = gyroSensor->rpmNotchWeight[motor][harmonic];
+            if (weight > 0.0f) {
+                const float notched = biquadFilterApplyDF1(&gyroSensor->rpmNotchFilter[motor][harmonic][axis], value);
+                value += weight * (notched - value);
+            }
+        }
+    }
+    return value;
+}
+#endif
+
 static void gyroInitSensorFilters(gyroSensor_t *gyroSensor)
 {
     gyroInitFilterLpf(gyroSensor, gyroConfig()->gyro_soft_lpf_hz);
     gyroInitFilterNotch1(gyroSensor, gyroConfig()->gyro_soft_notch_hz_1, gyroConfig()->gyro_soft_notch_cutoff_1);
     gyroInitFilterNotch2(gyroSensor, gyroConfig()->gyro_soft_notch_hz_2, gyroConfig()->gyro_soft_notch_cutoff_2);
     gyroInitFilterDynamicNotch(gyroSensor);
+#ifdef USE_RPM_FILTER
+    gyroInitFilterRpmNotch(gyroSensor);
+#endif
 }
 
 void gyroInitFilters(void)
@@ -560,6 +673,12 @@ void gyroUpdateSensor(gyroSensor_t *gyroSensor)
     gyroDataAnalyse(&gyroSensor->gyroDev, gyroSensor->notchFilterDyn);
 #endif
 
+#ifdef USE_RPM_FILTER
+    if (gyroSensor->rpmNotchHarmonics) {
+        gyroUpdateRpmNotch(gyroSensor);
+    }
+#endif
+
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
         // scale gyro output to degrees per second
         float gyroADCf = (float)gyroSensor->gyroDev.gyroADC[axis] * gyroSensor->gyroDev.scale;
@@ -569,13 +688,23 @@ void gyroUpdateSensor(gyroSensor_t *gyroSensor)
         if (axis == 0)
             DEBUG_SET(DEBUG_FFT, 0, lrintf(gyroADCf)); // store raw data
 
-        if (isDynamicFilterActive())
-            gyroADCf = gyroSensor->notchFilterDynApplyFn(&gyroSensor->notchFilterDyn[axis], gyroADCf);
+        if (isDynamicFilterActive()) {
+            for (int notch = 0; notch < gyroDynNotchCount(); notch++) {
+                gyroADCf = gyroSensor->notchFilterDynApplyFn(&gyroSensor->notchFilterDyn[notch][axis], gyroADCf);
+            }
+        }
 
         if (axis == 0)
             DEBUG_SET(DEBUG_FFT, 1, lrintf(gyroADCf)); // store data after dynamic notch
 #endif
 
+#ifdef USE_RPM_FILTER
+        // Apply motor rpm notch filtering
+        if (gyroSensor->rpmNotchHarmonics) {
+            gyroADCf = gyroApplyRpmNotch(gyroSensor, axis, gyroADCf);
+        }
+#endif
+
         // Apply Static Notch filtering
         DEBUG_SET(DEBUG_NOTCH, axis, lrintf(gyroADCf));
         gyroADCf = gyroSensor->notchFilter1ApplyFn(&gyroSensor->notchFilter1[axis], gyroADCf);
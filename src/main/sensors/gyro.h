@@ -60,6 +60,15 @@ typedef struct gyroConfig_s {
     uint16_t gyro_soft_notch_cutoff_1;
     uint16_t gyro_soft_notch_hz_2;
     uint16_t gyro_soft_notch_cutoff_2;
+#ifdef USE_RPM_FILTER
+    uint8_t  gyro_rpm_notch_harmonics;         // number of motor rpm harmonics to notch, 0 disables the rpm filter
+    uint8_t  gyro_rpm_notch_min_hz;            // lowest frequency the rpm notches are allowed to track down to
+    uint16_t gyro_rpm_notch_q;                 // notch Q * 100
+#endif
+#ifdef USE_GYRO_DATA_ANALYSE
+    uint8_t  dyn_fft_window;                   // samples per FFT window, 32, 64 or 128
+    uint8_t  dyn_notch_count;                  // number of spectrum peaks tracked per axis, each with its own notch
+#endif
 } gyroConfig_t;
 
 PG_DECLARE(gyroConfig_t, gyroConfig);
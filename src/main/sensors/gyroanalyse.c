@@ -47,8 +47,9 @@
 // The FFT splits the frequency domain into an number of bins
 // A sampling frequency of 1000 and max frequency of 500 at a window size of 32 gives 16 frequency bins each with a width 31.25Hz
 // Eg [0,31), [31,62), [62, 93) etc
+// Windows of 64 and 128 samples give 32 and 64 bins of 15.6Hz and 7.8Hz, at the cost of a longer window and more work per step
 
-#define FFT_WINDOW_SIZE                32  // max for f3 targets
+#define FFT_WINDOW_SIZE_MIN            32
 #define FFT_MIN_FREQ                  100  // not interested in filtering frequencies below 100Hz
 #define FFT_SAMPLING_RATE            1000  // allows analysis up to 500Hz which is more than motors create
 #define FFT_BPF_HZ                    200  // use a bandpass on gyro data to ignore extreme low and extreme high frequencies
@@ -60,17 +61,23 @@
 #define BIQUAD_Q 1.0f / sqrtf(2.0f)         // quality factor - butterworth
 
 static uint16_t samplingFrequency;          // gyro rate
+static uint8_t fftWindowSize;
 static uint8_t fftBinCount;
+static uint8_t fftStartBin;                 // first bin above FFT_MIN_FREQ
 static float fftResolution;                 // hz per bin
-static float gyroData[3][FFT_WINDOW_SIZE];  // gyro data used for frequency analysis
+static float gyroData[3][FFT_WINDOW_SIZE_MAX];  // gyro data used for frequency analysis
 
 static arm_rfft_fast_instance_f32 fftInstance;
-static float fftData[FFT_WINDOW_SIZE];
-static float rfftData[FFT_WINDOW_SIZE];
+static float fftData[FFT_WINDOW_SIZE_MAX];
+static float rfftData[FFT_WINDOW_SIZE_MAX];
 static gyroFftData_t fftResult[3];
 static uint16_t fftMaxFreq = 0;             // nyquist rate
-static uint16_t fftIdx = 0;                 // use a circular buffer for the last FFT_WINDOW_SIZE samples
+static uint16_t fftIdx = 0;                 // use a circular buffer for the last fftWindowSize samples
+static uint8_t dynNotchCount = 1;
 
+// peaks found by the last STEP_CALC_FREQUENCIES, waiting for STEP_UPDATE_FILTERS
+static uint8_t fftPeakCount;
+static float fftPeakFreq[DYN_NOTCH_COUNT_MAX];
 
 // accumulator for oversampled data => no aliasing and less noise
 static float fftAcc[3] = {0, 0, 0};
@@ -80,23 +87,23 @@ static int fftSamplingScale;
 // bandpass filter gyro data
 static biquadFilter_t fftGyroFilter[3];
 
-// filter for smoothing frequency estimation
-static biquadFilter_t fftFreqFilter[3];
+// filter for smoothing frequency estimation, one per tracked peak
+static biquadFilter_t fftFreqFilter[3][DYN_NOTCH_COUNT_MAX];
 
 // Hanning window, see https://en.wikipedia.org/wiki/Window_function#Hann_.28Hanning.29_window
-static float hanningWindow[FFT_WINDOW_SIZE];
+static float hanningWindow[FFT_WINDOW_SIZE_MAX];
 
 void initHanning()
 {
-    for (int i = 0; i < FFT_WINDOW_SIZE; i++) {
-        hanningWindow[i] = (0.5 - 0.5 * cosf(2 * M_PIf * i / (FFT_WINDOW_SIZE - 1)));
+    for (int i = 0; i < fftWindowSize; i++) {
+        hanningWindow[i] = (0.5 - 0.5 * cosf(2 * M_PIf * i / (fftWindowSize - 1)));
     }
 }
 
 void initGyroData()
 {
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-        for (int i = 0; i < FFT_WINDOW_SIZE; i++) {
+        for (int i = 0; i < FFT_WINDOW_SIZE_MAX; i++) {
             gyroData[axis][i] = 0;
         }
     }
@@ -104,28 +111,38 @@ void initGyroData()
 
 static inline int fftFreqToBin(int freq)
 {
-    return ((FFT_WINDOW_SIZE / 2 - 1) * freq) / (fftMaxFreq);
+    return ((fftWindowSize / 2 - 1) * freq) / (fftMaxFreq);
 }
 
 void gyroDataAnalyseInit(uint32_t targetLooptimeUs)
 {
+    // the rfft only supports power of two lengths, round the configured window down to one
+    fftWindowSize = FFT_WINDOW_SIZE_MIN;
+    while (fftWindowSize * 2 <= MIN(gyroConfig()->dyn_fft_window, FFT_WINDOW_SIZE_MAX)) {
+        fftWindowSize *= 2;
+    }
+    dynNotchCount = constrain(gyroConfig()->dyn_notch_count, 1, DYN_NOTCH_COUNT_MAX);
+
     // initialise even if FEATURE_DYNAMIC_FILTER not set, since it may be set later
     samplingFrequency = 1000000 / targetLooptimeUs;
     fftSamplingScale = samplingFrequency / FFT_SAMPLING_RATE;
     fftMaxFreq = FFT_SAMPLING_RATE / 2;
     fftBinCount = fftFreqToBin(fftMaxFreq) + 1;
-    fftResolution = FFT_SAMPLING_RATE / FFT_WINDOW_SIZE;
-    arm_rfft_fast_init_f32(&fftInstance, FFT_WINDOW_SIZE);
+    fftResolution = (float)FFT_SAMPLING_RATE / fftWindowSize;
+    fftStartBin = MAX(lrintf(FFT_MIN_FREQ / fftResolution), 1);
+    arm_rfft_fast_init_f32(&fftInstance, fftWindowSize);
 
     initGyroData();
     initHanning();
 
-    // recalculation of filters takes 4 calls per axis => each filter gets updated every 3 * 4 = 12 calls
-    // at 4khz gyro loop rate this means 4khz / 4 / 3 = 333Hz => update every 3ms
-    float looptime = targetLooptimeUs * 4 * 3;
+    // recalculation of filters takes 3 calls plus one per notch for each axis => each filter gets updated every 3 * (3 + dynNotchCount) calls
+    // at 4khz gyro loop rate and a single notch this means 4khz / 4 / 3 = 333Hz => update every 3ms
+    float looptime = targetLooptimeUs * (3 + dynNotchCount) * 3;
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-        fftResult[axis].centerFreq = 200; // any init value
-        biquadFilterInitLPF(&fftFreqFilter[axis], DYN_NOTCH_CHANGERATE, looptime);
+        for (int peak = 0; peak < DYN_NOTCH_COUNT_MAX; peak++) {
+            fftResult[axis].centerFreq[peak] = 200 + 100 * peak; // any init value
+            biquadFilterInitLPF(&fftFreqFilter[axis][peak], DYN_NOTCH_CHANGERATE, looptime);
+        }
         biquadFilterInit(&fftGyroFilter[axis], FFT_BPF_HZ, 1000000 / FFT_SAMPLING_RATE, BIQUAD_Q, FILTER_BPF);
     }
 }
@@ -136,6 +153,11 @@ const gyroFftData_t *gyroFftData(int axis)
     return &fftResult[axis];
 }
 
+int gyroDynNotchCount(void)
+{
+    return dynNotchCount;
+}
+
 bool isDynamicFilterActive(void)
 {
     return feature(FEATURE_DYNAMIC_FILTER);
@@ -144,7 +166,7 @@ bool isDynamicFilterActive(void)
 /*
  * Collect gyro data, to be analysed in gyroDataAnalyseUpdate function
  */
-void gyroDataAnalyse(const gyroDev_t *gyroDev, biquadFilter_t *notchFilterDyn)
+void gyroDataAnalyse(const gyroDev_t *gyroDev, biquadFilter_t (*notchFilterDyn)[XYZ_AXIS_COUNT])
 {
     if (!isDynamicFilterActive()) {
         return;
@@ -170,13 +192,71 @@ void gyroDataAnalyse(const gyroDev_t *gyroDev, biquadFilter_t *notchFilterDyn)
             fftAcc[axis] = 0;
         }
 
-        fftIdx = (fftIdx + 1) % FFT_WINDOW_SIZE;
+        fftIdx = (fftIdx + 1) % fftWindowSize;
     }
 
     // calculate FFT and update filters
     gyroDataAnalyseUpdate(notchFilterDyn);
 }
 
+/*
+ * Find the largest local maxima of the magnitude spectrum in fftData, refine each to a fraction of a bin
+ * by fitting a parabola through it and its neighbours, and return them in ascending frequency order
+ */
+static int fftFindPeaks(float *peakFreq, int maxPeaks)
+{
+    float peakVal[DYN_NOTCH_COUNT_MAX];
+    int peakCount = 0;
+
+    // only peaks standing out of the mean noise floor are worth a notch
+    float fftSum = 0;
+    for (int i = fftStartBin; i < fftBinCount; i++) {
+        fftSum += fftData[i];
+    }
+    const float threshold = fftSum / (fftBinCount - fftStartBin);
+
+    for (int i = fftStartBin; i < fftBinCount - 1; i++) {
+        const float val = fftData[i];
+        if (val <= threshold || val <= fftData[i - 1] || val < fftData[i + 1]) {
+            continue;
+        }
+
+        // keep the strongest maxPeaks, sorted by magnitude
+        int slot = peakCount;
+        while (slot > 0 && peakVal[slot - 1] < val) {
+            slot--;
+        }
+        if (slot >= maxPeaks) {
+            continue;
+        }
+        for (int j = MIN(peakCount, maxPeaks - 1); j > slot; j--) {
+            peakVal[j] = peakVal[j - 1];
+            peakFreq[j] = peakFreq[j - 1];
+        }
+
+        const float y0 = fftData[i - 1];
+        const float y2 = fftData[i + 1];
+        const float denom = y0 - 2 * val + y2;
+        const float delta = denom != 0 ? constrainf(0.5f * (y0 - y2) / denom, -0.5f, 0.5f) : 0;
+
+        peakVal[slot] = val;
+        peakFreq[slot] = (i + delta) * fftResolution;
+        peakCount = MIN(peakCount + 1, maxPeaks);
+    }
+
+    // notches are assigned by frequency so each one follows the same peak from window to window
+    for (int i = 1; i < peakCount; i++) {
+        const float freq = peakFreq[i];
+        int j = i;
+        for (; j > 0 && peakFreq[j - 1] > freq; j--) {
+            peakFreq[j] = peakFreq[j - 1];
+        }
+        peakFreq[j] = freq;
+    }
+
+    return peakCount;
+}
+
 void stage_rfft_f32(arm_rfft_fast_instance_f32 * S, float32_t * p, float32_t * pOut);
 void arm_cfft_radix8by2_f32( arm_cfft_instance_f32 * S, float32_t * p1);
 void arm_cfft_radix8by4_f32( arm_cfft_instance_f32 * S, float32_t * p1);
@@ -195,12 +275,13 @@ typedef enum {
 } UpdateStep_e;
 
 /*
- * Analyse last gyro data from the last FFT_WINDOW_SIZE milliseconds
+ * Analyse last gyro data from the last fftWindowSize milliseconds
  */
-void gyroDataAnalyseUpdate(biquadFilter_t *notchFilterDyn)
+void gyroDataAnalyseUpdate(biquadFilter_t (*notchFilterDyn)[XYZ_AXIS_COUNT])
 {
     static int axis = 0;
     static int step = 0;
+    static int notch = 0;
     arm_cfft_instance_f32 * Sint = &(fftInstance.Sint);
 
     uint32_t startTime = 0;
@@ -211,7 +292,7 @@ void gyroDataAnalyseUpdate(biquadFilter_t *notchFilterDyn)
     switch (step) {
         case STEP_ARM_CFFT_F32:
         {
-            switch (FFT_WINDOW_SIZE / 2) {
+            switch (fftWindowSize / 2) {
             case 16:
                 // 16us
                 arm_cfft_radix8by2_f32(Sint, fftData);
@@ -222,7 +303,7 @@ void gyroDataAnalyseUpdate(biquadFilter_t *notchFilterDyn)
                 break;
             case 64:
                 // 70us
-                arm_radix8_butterfly_f32(fftData, FFT_WINDOW_SIZE / 2, Sint->pTwiddle, 1);
+                arm_radix8_butterfly_f32(fftData, fftWindowSize / 2, Sint->pTwiddle, 1);
                 break;
             }
             DEBUG_SET(DEBUG_FFT_TIME, 1, micros() - startTime);
@@ -255,50 +336,46 @@ void gyroDataAnalyseUpdate(biquadFilter_t *notchFilterDyn)
         case STEP_CALC_FREQUENCIES:
         {
             // 13us
-            float fftSum = 0;
-            float fftWeightedSum = 0;
-
             fftResult[axis].maxVal = 0;
-            // iterate over fft data and calculate weighted indexes
-            float squaredData;
-            for (int i = 0; i < fftBinCount; i++) {
-                squaredData = fftData[i] * fftData[i];  //more weight on higher peaks
-                fftResult[axis].maxVal = MAX(fftResult[axis].maxVal, squaredData);
-                fftSum += squaredData;
-                fftWeightedSum += squaredData * (i + 1); // calculate weighted index starting at 1, not 0
+            for (int i = fftStartBin; i < fftBinCount; i++) {
+                fftResult[axis].maxVal = MAX(fftResult[axis].maxVal, fftData[i] * fftData[i]);
             }
 
-            // get weighted center of relevant frequency range (this way we have a better resolution than 31.25Hz)
-            if (fftSum > 0) {
-                // idx was shifted by 1 to start at 1, not 0
-                float fftMeanIndex = (fftWeightedSum / fftSum) - 1;
-                // the index points at the center frequency of each bin so index 0 is actually 16.125Hz
-                // fftMeanIndex += 0.5;
-
-                // don't go below the minimal cutoff frequency + 10 and don't jump around too much
-                float centerFreq;
-                centerFreq = constrain(fftMeanIndex * fftResolution, DYN_NOTCH_MIN_CUTOFF + 10, fftMaxFreq);
-                centerFreq = biquadFilterApply(&fftFreqFilter[axis], centerFreq);
-                centerFreq = constrain(centerFreq, DYN_NOTCH_MIN_CUTOFF + 10, fftMaxFreq);
-                fftResult[axis].centerFreq = centerFreq;
-                if (axis == 0) {
-                    DEBUG_SET(DEBUG_FFT, 3, lrintf(fftMeanIndex * 100));
-                }
+            fftPeakCount = fftFindPeaks(fftPeakFreq, dynNotchCount);
+            notch = 0;
+            if (axis == 0 && fftPeakCount > 0) {
+                DEBUG_SET(DEBUG_FFT, 3, lrintf(fftPeakFreq[0] / fftResolution * 100));
             }
 
-            DEBUG_SET(DEBUG_FFT_FREQ, axis, fftResult[axis].centerFreq);
             DEBUG_SET(DEBUG_FFT_TIME, 1, micros() - startTime);
             break;
         }
         case STEP_UPDATE_FILTERS:
         {
-            // 7us
-            // calculate new filter coefficients
-            float cutoffFreq = constrain(fftResult[axis].centerFreq - DYN_NOTCH_WIDTH, DYN_NOTCH_MIN_CUTOFF, DYN_NOTCH_MAX_CUTOFF);
-            float notchQ = filterGetNotchQApprox(fftResult[axis].centerFreq, cutoffFreq);
-            biquadFilterUpdate(&notchFilterDyn[axis], fftResult[axis].centerFreq, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+            // 7us per notch
+            // notches without a peak in this window keep their last frequency
+            if (notch < fftPeakCount) {
+                // don't go below the minimal cutoff frequency + 10 and don't jump around too much
+                float centerFreq;
+                centerFreq = constrain(fftPeakFreq[notch], DYN_NOTCH_MIN_CUTOFF + 10, fftMaxFreq);
+                centerFreq = biquadFilterApply(&fftFreqFilter[axis][notch], centerFreq);
+                centerFreq = constrain(centerFreq, DYN_NOTCH_MIN_CUTOFF + 10, fftMaxFreq);
+                fftResult[axis].centerFreq[notch] = centerFreq;
+
+                // calculate new filter coefficients
+                float cutoffFreq = constrain(fftResult[axis].centerFreq[notch] - DYN_NOTCH_WIDTH, DYN_NOTCH_MIN_CUTOFF, DYN_NOTCH_MAX_CUTOFF);
+                float notchQ = filterGetNotchQApprox(fftResult[axis].centerFreq[notch], cutoffFreq);
+                biquadFilterUpdate(&notchFilterDyn[notch][axis], fftResult[axis].centerFreq[notch], gyro.targetLooptime, notchQ, FILTER_NOTCH);
+            }
             DEBUG_SET(DEBUG_FFT_TIME, 1, micros() - startTime);
 
+            // one notch per call, stay on this step until all of them are done
+            if (++notch < dynNotchCount) {
+                return;
+            }
+
+            DEBUG_SET(DEBUG_FFT_FREQ, axis, fftResult[axis].centerFreq[0]);
+
             axis = (axis + 1) % 3;
             step++;
             // fall through
@@ -308,7 +385,7 @@ void gyroDataAnalyseUpdate(biquadFilter_t *notchFilterDyn)
             // 5us
             // apply hanning window to gyro samples and store result in fftData
             // hanning starts and ends with 0, could be skipped for minor speed improvement
-            uint8_t ringBufIdx = FFT_WINDOW_SIZE - fftIdx;
+            uint8_t ringBufIdx = fftWindowSize - fftIdx;
             arm_mult_f32(&gyroData[axis][fftIdx], &hanningWindow[0], &fftData[0], ringBufIdx);
             if (fftIdx > 0)
                 arm_mult_f32(&gyroData[axis][0], &hanningWindow[ringBufIdx], &fftData[ringBufIdx], fftIdx);
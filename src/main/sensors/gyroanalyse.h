@@ -18,17 +18,26 @@
 #pragma once
 
 #include "common/time.h"
+#include "common/axis.h"
 #include "common/filter.h"
 
-#define GYRO_FFT_BIN_COUNT      16 // FFT_WINDOW_SIZE / 2
+#ifdef STM32F3
+#define FFT_WINDOW_SIZE_MAX     32  // max for f3 targets
+#else
+#define FFT_WINDOW_SIZE_MAX    128
+#endif
+#define GYRO_FFT_BIN_COUNT      (FFT_WINDOW_SIZE_MAX / 2)
+#define DYN_NOTCH_COUNT_MAX     3
+
 typedef struct gyroFftData_s {
     float maxVal;
-    uint16_t centerFreq;
+    uint16_t centerFreq[DYN_NOTCH_COUNT_MAX];   // tracked peaks in ascending frequency order
 } gyroFftData_t;
 
 void gyroDataAnalyseInit(uint32_t targetLooptime);
 const gyroFftData_t *gyroFftData(int axis);
+int gyroDynNotchCount(void);
 struct gyroDev_s;
-void gyroDataAnalyse(const struct gyroDev_s *gyroDev, biquadFilter_t *notchFilterDyn);
-void gyroDataAnalyseUpdate(biquadFilter_t *notchFilterDyn);
+void gyroDataAnalyse(const struct gyroDev_s *gyroDev, biquadFilter_t (*notchFilterDyn)[XYZ_AXIS_COUNT]);
+void gyroDataAnalyseUpdate(biquadFilter_t (*notchFilterDyn)[XYZ_AXIS_COUNT]);
 bool isDynamicFilterActive();
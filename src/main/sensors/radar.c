@@ -29,12 +29,11 @@ static int16_t applyRadarMedianFilter(int16_t newRadarReading);
 static serialPort_t *radarSerialPort;
 
 void radarUpdate(timeUs_t currentTimeUs) {
-    UNUSED(currentTimeUs);
-
     if (radarFrameComplete) {
     	radar.radarDistance = radar.dev.getDistance(&radarFrame[0]);
     	radar.radarDistance = constrain(radar.radarDistance, 0, radar.radarMaxRangeCm);
     	radar.radarVelocity = radar.dev.getVelocity(&radarFrame[0]);
+    	radar.radarUpdateTimeUs = currentTimeUs;
     	//For displaying Data in Cleanflight Configurator
     	debug[0] = applyRadarMedianFilter((int16_t) radar.radarDistance);
     	debug[1] = (int16_t) radar.radarVelocity;
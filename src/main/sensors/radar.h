@@ -23,6 +23,7 @@
 #include "string.h"
 #include "platform.h"
 #include "common/maths.h"
+#include "common/time.h"
 
 
 typedef int32_t (*radarOpFuncPtr)(volatile uint8_t *radarFrame);
@@ -42,6 +43,7 @@ typedef struct radar_s {
 	int32_t radarMaxRangeCm;
 	int32_t radarVelocity;
 	uint16_t radarDetectionConeDecidegrees;
+	timeUs_t radarUpdateTimeUs;		// time the last valid frame was decoded
 }radar_t;
 
 
@@ -66,6 +68,8 @@ typedef enum {
 #define RADAR_FRAME_BEGIN_BYTE 0xAA
 #define RADAR_FRAME_STOP_BYTE  0xBB
 
+extern radar_t radar;
+
 bool radarDetect(void);
 void radarUpdate(timeUs_t currentTimeUs);
 
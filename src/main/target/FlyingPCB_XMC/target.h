@@ -46,6 +46,7 @@
 #define VBAT_SCALE_DEFAULT 		80
 
 #define USE_ONBOARD_ESC
+#define USE_RPM_FILTER
 
 #define TARGET_IO_PORT0         0xffff
 #define TARGET_IO_PORT1         0xffff
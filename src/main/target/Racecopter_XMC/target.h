@@ -49,6 +49,9 @@
 #define USE_SERIALRX_JETIEXBUS
 #define USE_RX_MSP
 
+#define USE_DSHOT
+#define USE_DSHOT_TELEMETRY
+#define USE_RPM_FILTER
 #define USE_SERIAL_4WAY_BLHELI_INTERFACE
 //#define USE_ESCSERIAL
 
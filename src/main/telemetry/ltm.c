@@ -85,17 +85,25 @@ static bool ltmEnabled;
 static portSharing_e ltmPortSharing;
 static uint8_t ltm_crc;
 
+// largest frames are the G- and O-frame: 3 header bytes, 14 payload bytes and the crc
+#define LTM_MAX_FRAME_SIZE 18
+
+// frames are assembled here and written to the port in one go by ltm_finalise()
+static uint8_t ltmFrame[LTM_MAX_FRAME_SIZE];
+static uint8_t ltmFrameLength;
+
 static void ltm_initialise_packet(uint8_t ltm_id)
 {
     ltm_crc = 0;
-    serialWrite(ltmPort, '$');
-    serialWrite(ltmPort, 'T');
-    serialWrite(ltmPort, ltm_id);
+    ltmFrame[0] = '$';
+    ltmFrame[1] = 'T';
+    ltmFrame[2] = ltm_id;
+    ltmFrameLength = 3;
 }
 
 static void ltm_serialise_8(uint8_t v)
 {
-    serialWrite(ltmPort, v);
+    ltmFrame[ltmFrameLength++] = v;
     ltm_crc ^= v;
 }
 
@@ -115,7 +123,8 @@ static void ltm_serialise_32(uint32_t v)
 
 static void ltm_finalise(void)
 {
-    serialWrite(ltmPort, ltm_crc);
+    ltmFrame[ltmFrameLength++] = ltm_crc;
+    serialWriteBuf(ltmPort, ltmFrame, ltmFrameLength);
 }
 
 /*
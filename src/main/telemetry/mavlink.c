@@ -79,6 +79,12 @@
 #define TELEMETRY_MAVLINK_INITIAL_PORT_MODE MODE_TX
 #define TELEMETRY_MAVLINK_MAXRATE 50
 #define TELEMETRY_MAVLINK_DELAY ((1000 * 1000) / TELEMETRY_MAVLINK_MAXRATE)
+// attitude is sent at up to TELEMETRY_MAVLINK_MAXRATE but takes no more than 1/N of the link
+#define TELEMETRY_MAVLINK_ATTITUDE_SHARE 2
+// messages of one scheduler tick are collected and written to the port together
+#define TELEMETRY_MAVLINK_TX_BUFFER_SIZE 256
+// largest single stream burst: GPS_RAW_INT, GLOBAL_POSITION_INT and GPS_GLOBAL_ORIGIN
+#define TELEMETRY_MAVLINK_TX_RESERVE 96
 
 extern uint16_t rssi; // FIXME dependency on mw.c
 
@@ -88,36 +94,75 @@ static serialPortConfig_t *portConfig;
 static bool mavlinkTelemetryEnabled =  false;
 static portSharing_e mavlinkPortSharing;
 
-/* MAVLink datastream rates in Hz */
+/* MAVLink datastream rates in Hz, attitude (EXTRA1) is limited by the link speed */
 static const uint8_t mavRates[] = {
     [MAV_DATA_STREAM_EXTENDED_STATUS] = 2, //2Hz
     [MAV_DATA_STREAM_RC_CHANNELS] = 5, //5Hz
     [MAV_DATA_STREAM_POSITION] = 2, //2Hz
-    [MAV_DATA_STREAM_EXTRA1] = 10, //10Hz
+    [MAV_DATA_STREAM_EXTRA1] = 50, //50Hz
     [MAV_DATA_STREAM_EXTRA2] = 10 //2Hz
 };
 
 #define MAXSTREAMS (sizeof(mavRates) / sizeof(mavRates[0]))
 
+static uint8_t mavStreamRates[MAXSTREAMS];
 static uint8_t mavTicks[MAXSTREAMS];
 static mavlink_message_t mavMsg;
 static uint8_t mavBuffer[MAVLINK_MAX_PACKET_LEN];
 static uint32_t lastMavlinkMessage = 0;
 
+// link budget in bytes, refilled every scheduler tick and allowed to go negative by the last message sent
+static int32_t mavlinkTxBudget;
+static int32_t mavlinkTxBytesPerTick;
+static uint16_t mavlinkTxReserve;
+
+static uint8_t mavlinkTxBuffer[TELEMETRY_MAVLINK_TX_BUFFER_SIZE];
+static uint16_t mavlinkTxLength;
+
+static void mavlinkConfigureStreams(void)
+{
+    // 10 bits per byte on the wire
+    const uint32_t linkBytesPerSecond = mavlinkPort->baudRate / 10;
+    const uint32_t attitudeMaxRate = linkBytesPerSecond / TELEMETRY_MAVLINK_ATTITUDE_SHARE / (MAVLINK_MSG_ID_ATTITUDE_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES);
+
+    for (unsigned i = 0; i < MAXSTREAMS; i++) {
+        mavStreamRates[i] = mavRates[i];
+    }
+    mavStreamRates[MAV_DATA_STREAM_EXTRA1] = constrain(attitudeMaxRate, 1, mavRates[MAV_DATA_STREAM_EXTRA1]);
+
+    mavlinkTxBytesPerTick = MAX(linkBytesPerSecond / TELEMETRY_MAVLINK_MAXRATE, 1);
+    mavlinkTxReserve = MIN(TELEMETRY_MAVLINK_TX_RESERVE, mavlinkPort->txBufferSize / 2);
+    mavlinkTxBudget = 0;
+    mavlinkTxLength = 0;
+    memset(mavTicks, 0, sizeof(mavTicks));
+}
+
+static bool mavlinkTxAvailable(void)
+{
+    // the uart buffer must also hold what is collected for this tick plus one more stream burst
+    return mavlinkTxBudget > 0 && serialTxBytesFree(mavlinkPort) >= mavlinkTxLength + mavlinkTxReserve;
+}
+
 static int mavlinkStreamTrigger(enum MAV_DATA_STREAM streamNum)
 {
-    uint8_t rate = (uint8_t) mavRates[streamNum];
+    uint8_t rate = mavStreamRates[streamNum];
     if (rate == 0) {
         return 0;
     }
 
     if (mavTicks[streamNum] == 0) {
+        // due, but held back while the link is saturated; lower priority streams are asked last and degrade first
+        if (!mavlinkTxAvailable()) {
+            return 0;
+        }
+
         // we're triggering now, setup the next trigger point
         if (rate > TELEMETRY_MAVLINK_MAXRATE) {
             rate = TELEMETRY_MAVLINK_MAXRATE;
         }
 
-        mavTicks[streamNum] = (TELEMETRY_MAVLINK_MAXRATE / rate);
+        // the countdown includes this tick, so rate == TELEMETRY_MAVLINK_MAXRATE fires every tick
+        mavTicks[streamNum] = (TELEMETRY_MAVLINK_MAXRATE / rate) - 1;
         return 1;
     }
 
@@ -127,10 +172,22 @@ static int mavlinkStreamTrigger(enum MAV_DATA_STREAM streamNum)
 }
 
 
+static void mavlinkFlush(void)
+{
+    if (mavlinkTxLength) {
+        serialWriteBuf(mavlinkPort, mavlinkTxBuffer, mavlinkTxLength);
+        mavlinkTxLength = 0;
+    }
+}
+
 static void mavlinkSerialWrite(uint8_t * buf, uint16_t length)
 {
-    for (int i = 0; i < length; i++)
-        serialWrite(mavlinkPort, buf[i]);
+    if (mavlinkTxLength + length > sizeof(mavlinkTxBuffer)) {
+        mavlinkFlush();
+    }
+    memcpy(&mavlinkTxBuffer[mavlinkTxLength], buf, length);
+    mavlinkTxLength += length;
+    mavlinkTxBudget -= length;
 }
 
 void freeMAVLinkTelemetryPort(void)
@@ -164,6 +221,7 @@ void configureMAVLinkTelemetryPort(void)
         return;
     }
 
+    mavlinkConfigureStreams();
     mavlinkTelemetryEnabled = true;
 }
 
@@ -172,6 +230,7 @@ void checkMAVLinkTelemetryState(void)
     if (portConfig && telemetryCheckRxPortShared(portConfig)) {
         if (!mavlinkTelemetryEnabled && telemetrySharedPort != NULL) {
             mavlinkPort = telemetrySharedPort;
+            mavlinkConfigureStreams();
             mavlinkTelemetryEnabled = true;
         }
     } else {
@@ -516,6 +575,17 @@ void mavlinkSendHUDAndHeartbeat(void)
 void processMAVLinkTelemetry(void)
 {
     // is executed @ TELEMETRY_MAVLINK_MAXRATE rate
+    mavlinkTxBudget = MIN(mavlinkTxBudget + mavlinkTxBytesPerTick, 2 * mavlinkTxBytesPerTick);
+
+    // streams in priority order
+    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA1)) {
+        mavlinkSendAttitude();
+    }
+
+    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA2)) {
+        mavlinkSendHUDAndHeartbeat();
+    }
+
     if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTENDED_STATUS)) {
         mavlinkSendSystemStatus();
     }
@@ -530,13 +600,7 @@ void processMAVLinkTelemetry(void)
     }
 #endif
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA1)) {
-        mavlinkSendAttitude();
-    }
-
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA2)) {
-        mavlinkSendHUDAndHeartbeat();
-    }
+    mavlinkFlush();
 }
 
 void handleMAVLinkTelemetry(void)
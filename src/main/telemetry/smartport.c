@@ -255,35 +255,38 @@ static void smartPortDataReceive(uint16_t c)
     }
 }
 
-static void smartPortSendByte(uint8_t c, uint16_t *crcp)
+// frame id, payload and crc, each of which may be escaped to two bytes
+#define SMARTPORT_TX_FRAME_SIZE ((1 + SMARTPORT_PAYLOAD_SIZE + 1) * 2)
+
+static uint8_t *smartPortStuffByte(uint8_t *dst, uint8_t c)
 {
     // smart port escape sequence
     if (c == FSSP_DLE || c == FSSP_START_STOP) {
-        serialWrite(smartPortSerialPort, FSSP_DLE);
-        serialWrite(smartPortSerialPort, c ^ FSSP_DLE_XOR);
-    }
-    else {
-        serialWrite(smartPortSerialPort, c);
+        *dst++ = FSSP_DLE;
+        *dst++ = c ^ FSSP_DLE_XOR;
+    } else {
+        *dst++ = c;
     }
-
-    if (crcp == NULL)
-        return;
-
-    uint16_t crc = *crcp;
-    crc += c;
-    crc += crc >> 8;
-    crc &= 0x00FF;
-    *crcp = crc;
+    return dst;
 }
 
 static void smartPortSendPackageEx(uint8_t frameId, uint8_t* data)
 {
-    uint16_t crc = 0;
-    smartPortSendByte(frameId, &crc);
-    for(unsigned i = 0; i < SMARTPORT_PAYLOAD_SIZE; i++) {
-        smartPortSendByte(*data++, &crc);
+    uint8_t frame[SMARTPORT_TX_FRAME_SIZE];
+    uint8_t *dst = frame;
+    uint16_t crc = frameId;
+
+    dst = smartPortStuffByte(dst, frameId);
+    for (unsigned i = 0; i < SMARTPORT_PAYLOAD_SIZE; i++) {
+        const uint8_t c = *data++;
+        dst = smartPortStuffByte(dst, c);
+        crc += c;
+        crc += crc >> 8;
+        crc &= 0x00FF;
     }
-    smartPortSendByte(0xFF - (uint8_t)crc, NULL);
+    dst = smartPortStuffByte(dst, 0xFF - (uint8_t)crc);
+
+    serialWriteBuf(smartPortSerialPort, frame, dst - frame);
 }
 
 static void smartPortSendPackage(uint16_t id, uint32_t val)
@@ -0,0 +1,774 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host round trip test and benchmark for blackbox/blackbox_encoding.c.
+ *
+ * Every encoder is fed edge values, random values of every magnitude and a synthetic flight
+ * trace, the output is read back with a decoder that follows the blackbox log format, and the
+ * decoded fields must match the input exactly. A recorded value stream (whitespace separated
+ * integers, one channel after the other) can be given on the command line and is replayed
+ * through every encoder the same way. Encoded bytes per frame and encode time per frame are
+ * reported for the synthetic trace and the replay.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "blackbox/blackbox_encoding.h"
+#include "blackbox/blackbox_io.h"
+
+#include "common/printf.h"
+
+#define STREAM_SIZE         (256 * 1024)
+#define CHUNK_FRAMES        4096
+#define MAX_FIELDS          8
+#define FUZZ_FRAMES         200000
+#define DEFAULT_FRAMES      100000
+
+static uint8_t stream[STREAM_SIZE];
+static size_t streamLength;
+static bool streamOverflow;
+
+static int failures;
+
+/*
+ * Firmware hooks used by blackbox_encoding.c
+ */
+
+int32_t blackboxHeaderBudget;
+
+void blackboxWrite(uint8_t value)
+{
+    if (streamLength < STREAM_SIZE) {
+        stream[streamLength++] = value;
+    } else {
+        streamOverflow = true;
+    }
+}
+
+int blackboxPrint(const char *s)
+{
+    const int length = strlen(s);
+
+    for (int i = 0; i < length; i++) {
+        blackboxWrite(s[i]);
+    }
+
+    return length;
+}
+
+int tfp_format(void *putp, void (*putf) (void *, char), const char *fmt, va_list va)
+{
+    char buffer[256];
+    const int length = vsnprintf(buffer, sizeof(buffer), fmt, va);
+
+    for (int i = 0; i < length && i < (int)sizeof(buffer) - 1; i++) {
+        putf(putp, buffer[i]);
+    }
+
+    return length;
+}
+
+static void streamReset(void)
+{
+    streamLength = 0;
+    streamOverflow = false;
+}
+
+/*
+ * Decoder, following the field encodings of the blackbox log format
+ */
+
+typedef struct decoder_s {
+    const uint8_t *pos;
+    const uint8_t *end;
+    bool overrun;
+} decoder_t;
+
+static uint8_t readByte(decoder_t *d)
+{
+    if (d->pos >= d->end) {
+        d->overrun = true;
+        return 0;
+    }
+    return *d->pos++;
+}
+
+static int32_t signExtend(uint32_t value, int bits)
+{
+    const uint32_t sign = 1u << (bits - 1);
+
+    value &= (sign << 1) - 1;
+    return (int32_t)((value ^ sign) - sign);
+}
+
+static uint32_t readUnsignedVB(decoder_t *d)
+{
+    uint32_t result = 0;
+
+    // 32 bits take at most 5 bytes of 7 bits each
+    for (int shift = 0; shift < 35; shift += 7) {
+        const uint8_t c = readByte(d);
+
+        result |= (uint32_t)(c & 0x7F) << shift;
+        if (c < 128) {
+            return result;
+        }
+    }
+
+    d->overrun = true;
+    return 0;
+}
+
+static int32_t readSignedVB(decoder_t *d)
+{
+    const uint32_t value = readUnsignedVB(d);
+
+    return (int32_t)((value >> 1) ^ -(value & 1));
+}
+
+static int32_t readS16(decoder_t *d)
+{
+    const uint32_t low = readByte(d);
+    const uint32_t high = readByte(d);
+
+    return signExtend(low | (high << 8), 16);
+}
+
+static uint32_t readU32(decoder_t *d)
+{
+    uint32_t value = 0;
+
+    for (int i = 0; i < 4; i++) {
+        value |= (uint32_t)readByte(d) << (8 * i);
+    }
+    return value;
+}
+
+// The trailing "sstt tttt" variant shared by both 2 bit tag encodings
+static void readTag2_3Bytes(decoder_t *d, uint8_t leadByte, int32_t *values)
+{
+    int selector2 = leadByte & 0x3F;
+
+    for (int x = 0; x < 3; x++, selector2 >>= 2) {
+        const int bytes = (selector2 & 0x03) + 1;
+        uint32_t value = 0;
+
+        for (int i = 0; i < bytes; i++) {
+            value |= (uint32_t)readByte(d) << (8 * i);
+        }
+        values[x] = bytes == 4 ? (int32_t)value : signExtend(value, 8 * bytes);
+    }
+}
+
+static void readTag2_3S32(decoder_t *d, int32_t *values)
+{
+    uint8_t leadByte = readByte(d);
+    uint8_t b;
+
+    switch (leadByte >> 6) {
+    case 0:
+        values[0] = signExtend(leadByte >> 4, 2);
+        values[1] = signExtend(leadByte >> 2, 2);
+        values[2] = signExtend(leadByte, 2);
+        break;
+    case 1:
+        values[0] = signExtend(leadByte, 4);
+        b = readByte(d);
+        values[1] = signExtend(b >> 4, 4);
+        values[2] = signExtend(b, 4);
+        break;
+    case 2:
+        values[0] = signExtend(leadByte, 6);
+        values[1] = signExtend(readByte(d), 6);
+        values[2] = signExtend(readByte(d), 6);
+        break;
+    case 3:
+        readTag2_3Bytes(d, leadByte, values);
+        break;
+    }
+}
+
+static void readTag2_3SVariable(decoder_t *d, int32_t *values)
+{
+    uint8_t leadByte = readByte(d);
+    uint8_t b1, b2;
+
+    switch (leadByte >> 6) {
+    case 0:
+        values[0] = signExtend(leadByte >> 4, 2);
+        values[1] = signExtend(leadByte >> 2, 2);
+        values[2] = signExtend(leadByte, 2);
+        break;
+    case 1:
+        // ss11 1112 2222 3333
+        b1 = readByte(d);
+        values[0] = signExtend(leadByte >> 1, 5);
+        values[1] = signExtend(((leadByte & 0x01) << 4) | (b1 >> 4), 5);
+        values[2] = signExtend(b1, 4);
+        break;
+    case 2:
+        // ss11 1111 1122 2222 2333 3333
+        b1 = readByte(d);
+        b2 = readByte(d);
+        values[0] = signExtend(((leadByte & 0x3F) << 2) | (b1 >> 6), 8);
+        values[1] = signExtend(((b1 & 0x3F) << 1) | (b2 >> 7), 7);
+        values[2] = signExtend(b2, 7);
+        break;
+    case 3:
+        readTag2_3Bytes(d, leadByte, values);
+        break;
+    }
+}
+
+static void readTag8_4S16(decoder_t *d, int32_t *values)
+{
+    uint8_t selector = readByte(d);
+    bool nibbleIndex = false;
+    uint8_t buffer = 0;
+    uint8_t c1, c2;
+
+    for (int x = 0; x < 4; x++, selector >>= 2) {
+        switch (selector & 0x03) {
+        case 0:
+            values[x] = 0;
+            break;
+        case 1:
+            if (!nibbleIndex) {
+                buffer = readByte(d);
+                values[x] = signExtend(buffer >> 4, 4);
+            } else {
+                values[x] = signExtend(buffer, 4);
+            }
+            nibbleIndex = !nibbleIndex;
+            break;
+        case 2:
+            if (!nibbleIndex) {
+                values[x] = signExtend(readByte(d), 8);
+            } else {
+                c1 = buffer << 4;
+                buffer = readByte(d);
+                values[x] = signExtend(c1 | (buffer >> 4), 8);
+            }
+            break;
+        case 3:
+            if (!nibbleIndex) {
+                c1 = readByte(d);
+                c2 = readByte(d);
+                values[x] = signExtend((c1 << 8) | c2, 16);
+            } else {
+                c1 = readByte(d);
+                c2 = readByte(d);
+                values[x] = signExtend(((buffer & 0x0F) << 12) | (c1 << 4) | (c2 >> 4), 16);
+                buffer = c2;
+            }
+            break;
+        }
+    }
+}
+
+static void readTag8_8SVB(decoder_t *d, int32_t *values, int valueCount)
+{
+    if (valueCount == 1) {
+        values[0] = readSignedVB(d);
+        return;
+    }
+
+    const uint8_t header = readByte(d);
+
+    for (int i = 0; i < valueCount; i++) {
+        values[i] = (header & (1 << i)) ? readSignedVB(d) : 0;
+    }
+}
+
+/*
+ * Encoders under test, each with the value range its callers are allowed to hand it
+ */
+
+typedef struct codec_s {
+    const char *name;
+    int fieldCount;
+    int32_t min;
+    int32_t max;
+    void (*encode)(int32_t *values, int count);
+    void (*decode)(decoder_t *d, int32_t *values, int count);
+} codec_t;
+
+static void encodeUnsignedVB(int32_t *values, int count)
+{
+    (void)count;
+    blackboxWriteUnsignedVB((uint32_t)values[0]);
+}
+
+static void decodeUnsignedVB(decoder_t *d, int32_t *values, int count)
+{
+    (void)count;
+    values[0] = (int32_t)readUnsignedVB(d);
+}
+
+static void encodeSignedVBArray(int32_t *values, int count)
+{
+    blackboxWriteSignedVBArray(values, count);
+}
+
+static void decodeSignedVBArray(decoder_t *d, int32_t *values, int count)
+{
+    for (int i = 0; i < count; i++) {
+        values[i] = readSignedVB(d);
+    }
+}
+
+static void encodeSigned16VBArray(int32_t *values, int count)
+{
+    int16_t values16[MAX_FIELDS];
+
+    for (int i = 0; i < count; i++) {
+        values16[i] = values[i];
+    }
+    blackboxWriteSigned16VBArray(values16, count);
+}
+
+static void encodeS16(int32_t *values, int count)
+{
+    (void)count;
+    blackboxWriteS16(values[0]);
+}
+
+static void decodeS16(decoder_t *d, int32_t *values, int count)
+{
+    (void)count;
+    values[0] = readS16(d);
+}
+
+static void encodeU32(int32_t *values, int count)
+{
+    (void)count;
+    blackboxWriteU32(values[0]);
+}
+
+static void decodeU32(decoder_t *d, int32_t *values, int count)
+{
+    (void)count;
+    values[0] = (int32_t)readU32(d);
+}
+
+static void encodeFloat(int32_t *values, int count)
+{
+    float f;
+
+    (void)count;
+    memcpy(&f, &values[0], sizeof(f));
+    blackboxWriteFloat(f);
+}
+
+static void encodeTag2_3S32(int32_t *values, int count)
+{
+    (void)count;
+    blackboxWriteTag2_3S32(values);
+}
+
+static void decodeTag2_3S32(decoder_t *d, int32_t *values, int count)
+{
+    (void)count;
+    readTag2_3S32(d, values);
+}
+
+static void encodeTag2_3SVariable(int32_t *values, int count)
+{
+    (void)count;
+    blackboxWriteTag2_3SVariable(values);
+}
+
+static void decodeTag2_3SVariable(decoder_t *d, int32_t *values, int count)
+{
+    (void)count;
+    readTag2_3SVariable(d, values);
+}
+
+static void encodeTag8_4S16(int32_t *values, int count)
+{
+    (void)count;
+    blackboxWriteTag8_4S16(values);
+}
+
+static void decodeTag8_4S16(decoder_t *d, int32_t *values, int count)
+{
+    (void)count;
+    readTag8_4S16(d, values);
+}
+
+static void encodeTag8_8SVB(int32_t *values, int count)
+{
+    blackboxWriteTag8_8SVB(values, count);
+}
+
+static void decodeTag8_8SVB(decoder_t *d, int32_t *values, int count)
+{
+    readTag8_8SVB(d, values, count);
+}
+
+static const codec_t codecs[] = {
+    { "UnsignedVB",       1, INT32_MIN, INT32_MAX, encodeUnsignedVB,      decodeUnsignedVB },
+    { "SignedVBArray",    4, INT32_MIN, INT32_MAX, encodeSignedVBArray,   decodeSignedVBArray },
+    { "Signed16VBArray",  3, INT16_MIN, INT16_MAX, encodeSigned16VBArray, decodeSignedVBArray },
+    { "S16",              1, INT16_MIN, INT16_MAX, encodeS16,             decodeS16 },
+    { "U32",              1, INT32_MIN, INT32_MAX, encodeU32,             decodeU32 },
+    { "Float",            1, INT32_MIN, INT32_MAX, encodeFloat,           decodeU32 },
+    { "Tag2_3S32",        3, INT32_MIN, INT32_MAX, encodeTag2_3S32,       decodeTag2_3S32 },
+    { "Tag2_3SVariable",  3, INT32_MIN, INT32_MAX, encodeTag2_3SVariable, decodeTag2_3SVariable },
+    { "Tag8_4S16",        4, INT16_MIN, INT16_MAX, encodeTag8_4S16,       decodeTag8_4S16 },
+    { "Tag8_8SVB/1",      1, INT32_MIN, INT32_MAX, encodeTag8_8SVB,       decodeTag8_8SVB },
+    { "Tag8_8SVB/5",      5, INT32_MIN, INT32_MAX, encodeTag8_8SVB,       decodeTag8_8SVB },
+    { "Tag8_8SVB/8",      8, INT32_MIN, INT32_MAX, encodeTag8_8SVB,       decodeTag8_8SVB },
+};
+
+#define CODEC_COUNT (sizeof(codecs) / sizeof(codecs[0]))
+
+/*
+ * Round trip
+ */
+
+typedef struct frameStats_s {
+    uint32_t frames;
+    uint64_t bytes;
+    uint64_t encodeNs;
+} frameStats_t;
+
+static uint64_t nanos(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static int32_t clampToCodec(const codec_t *codec, int64_t value)
+{
+    if (value < codec->min) {
+        return codec->min;
+    }
+    if (value > codec->max) {
+        return codec->max;
+    }
+    return value;
+}
+
+/*
+ * Encode frameCount frames of codec->fieldCount values each, decode them back and compare.
+ * Encoding is timed in chunks so the decoder and the comparison stay out of the measurement.
+ */
+static void roundTrip(const codec_t *codec, const char *source, const int32_t *frames, uint32_t frameCount, frameStats_t *stats)
+{
+    const int count = codec->fieldCount;
+
+    for (uint32_t start = 0; start < frameCount; start += CHUNK_FRAMES) {
+        const uint32_t chunk = frameCount - start < CHUNK_FRAMES ? frameCount - start : CHUNK_FRAMES;
+        const int32_t *chunkFrames = frames + (size_t)start * count;
+
+        streamReset();
+
+        const uint64_t startNs = nanos();
+        for (uint32_t i = 0; i < chunk; i++) {
+            codec->encode((int32_t *)&chunkFrames[(size_t)i * count], count);
+        }
+        const uint64_t endNs = nanos();
+
+        if (streamOverflow) {
+            printf("FAIL %s/%s: encode buffer overflow\n", codec->name, source);
+            failures++;
+            return;
+        }
+
+        stats->frames += chunk;
+        stats->bytes += streamLength;
+        stats->encodeNs += endNs - startNs;
+
+        decoder_t d = { stream, stream + streamLength, false };
+
+        for (uint32_t i = 0; i < chunk; i++) {
+            const int32_t *expected = &chunkFrames[(size_t)i * count];
+            int32_t decoded[MAX_FIELDS];
+
+            codec->decode(&d, decoded, count);
+
+            if (d.overrun || memcmp(decoded, expected, count * sizeof(int32_t)) != 0) {
+                printf("FAIL %s/%s frame %u:", codec->name, source, start + i);
+                for (int x = 0; x < count; x++) {
+                    printf(" %d->%d", expected[x], decoded[x]);
+                }
+                printf("\n");
+                failures++;
+                return;
+            }
+        }
+
+        if (d.pos != d.end) {
+            printf("FAIL %s/%s: %d trailing bytes\n", codec->name, source, (int)(d.end - d.pos));
+            failures++;
+            return;
+        }
+    }
+}
+
+static uint32_t randomState = 0x12345678;
+
+static uint32_t randomU32(void)
+{
+    // xorshift32, fixed seed so failures are reproducible
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+// Random value whose magnitude is spread evenly over every bit length
+static int64_t randomAnyMagnitude(void)
+{
+    const int bits = randomU32() % 33;
+    const int64_t magnitude = bits == 0 ? 0 : (int64_t)(randomU32() & (uint32_t)((1ull << bits) - 1));
+
+    return (randomU32() & 1) ? -magnitude : magnitude;
+}
+
+static double randomGaussian(void)
+{
+    const double u1 = (randomU32() + 1.0) / 4294967296.0;
+    const double u2 = randomU32() / 4294967296.0;
+
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static void testEdgeValues(const codec_t *codec)
+{
+    static const int64_t edges[] = {
+        0, 1, -1, 2, -2, 3, -3, 7, -8, 8, -9, 15, -16, 16, -17, 31, -32, 32, -33,
+        63, -64, 64, -65, 127, -128, 128, -129, 255, -256, 256, -257,
+        32767, -32768, 32768, -32769, 8388607, -8388608, 8388608, -8388609,
+        INT32_MAX, INT32_MIN
+    };
+    enum { EDGE_COUNT = sizeof(edges) / sizeof(edges[0]) };
+
+    // Every edge value in every field position, with the other fields zero or also at an edge
+    const int count = codec->fieldCount;
+    const uint32_t frameCount = EDGE_COUNT * EDGE_COUNT * count;
+    int32_t *frames = calloc((size_t)frameCount * count, sizeof(int32_t));
+    uint32_t n = 0;
+
+    for (int a = 0; a < EDGE_COUNT; a++) {
+        for (int b = 0; b < EDGE_COUNT; b++) {
+            for (int x = 0; x < count; x++, n++) {
+                for (int y = 0; y < count; y++) {
+                    frames[(size_t)n * count + y] = clampToCodec(codec, y == x ? edges[a] : (y & 1) ? edges[b] : 0);
+                }
+            }
+        }
+    }
+
+    frameStats_t stats = { 0, 0, 0 };
+    roundTrip(codec, "edges", frames, frameCount, &stats);
+    free(frames);
+}
+
+static void testRandomValues(const codec_t *codec)
+{
+    const int count = codec->fieldCount;
+    int32_t *frames = malloc((size_t)FUZZ_FRAMES * count * sizeof(int32_t));
+
+    for (size_t i = 0; i < (size_t)FUZZ_FRAMES * count; i++) {
+        frames[i] = clampToCodec(codec, randomAnyMagnitude());
+    }
+
+    frameStats_t stats = { 0, 0, 0 };
+    roundTrip(codec, "random", frames, FUZZ_FRAMES, &stats);
+    free(frames);
+}
+
+/*
+ * Synthetic flight trace: every field is a noisy signal whose noise level sweeps slowly between
+ * hover-like and flip-like, and the encoders see the frame to frame deltas, as P frames do.
+ */
+static int32_t *syntheticFlightDeltas(const codec_t *codec, uint32_t frameCount)
+{
+    const int count = codec->fieldCount;
+    int32_t *frames = malloc((size_t)frameCount * count * sizeof(int32_t));
+    double signal[MAX_FIELDS] = { 0 };
+    int64_t previous[MAX_FIELDS] = { 0 };
+
+    for (uint32_t i = 0; i < frameCount; i++) {
+        const double sigma = 1.0 + 400.0 * (1.0 - cos(2.0 * M_PI * i / 20000.0));
+
+        for (int x = 0; x < count; x++) {
+            signal[x] = 0.995 * signal[x] + sigma * randomGaussian();
+            const int64_t sample = (int64_t)lrint(signal[x]);
+            frames[(size_t)i * count + x] = clampToCodec(codec, sample - previous[x]);
+            previous[x] = sample;
+        }
+    }
+
+    return frames;
+}
+
+static int32_t *replayValues;
+static uint32_t replayValueCount;
+
+static bool loadReplay(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    uint32_t capacity = 4096;
+    long long value;
+
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    replayValues = malloc(capacity * sizeof(int32_t));
+    while (fscanf(f, "%lld", &value) == 1) {
+        if (replayValueCount == capacity) {
+            capacity *= 2;
+            replayValues = realloc(replayValues, capacity * sizeof(int32_t));
+        }
+        replayValues[replayValueCount++] = value < INT32_MIN ? INT32_MIN : value > INT32_MAX ? INT32_MAX : value;
+    }
+
+    fclose(f);
+    return replayValueCount > 0;
+}
+
+// The replayed stream cut into frames of the codec's width, delta coded against the previous frame
+static int32_t *replayDeltas(const codec_t *codec, uint32_t *frameCount)
+{
+    const int count = codec->fieldCount;
+    int32_t *frames;
+
+    *frameCount = replayValueCount / count;
+    frames = malloc(((size_t)*frameCount * count + 1) * sizeof(int32_t));
+
+    for (uint32_t i = 0; i < *frameCount; i++) {
+        for (int x = 0; x < count; x++) {
+            const size_t index = (size_t)i * count + x;
+            const int64_t previous = i > 0 ? replayValues[index - count] : 0;
+
+            frames[index] = clampToCodec(codec, (int64_t)replayValues[index] - previous);
+        }
+    }
+
+    return frames;
+}
+
+static void printStats(const codec_t *codec, const char *source, const frameStats_t *stats)
+{
+    if (stats->frames == 0) {
+        return;
+    }
+
+    printf("%-16s %-9s %9u %12.2f %10.1f\n", codec->name, source, stats->frames,
+        (double)stats->bytes / stats->frames, (double)stats->encodeNs / stats->frames);
+}
+
+static void testHeaderLine(void)
+{
+    streamReset();
+    blackboxHeaderBudget = 100;
+
+    blackboxPrintfHeaderLine("Field I name", "%s,%d", "loopIteration", 42);
+
+    static const char expected[] = "H Field I name:loopIteration,42\n";
+
+    if (streamLength != strlen(expected) || memcmp(stream, expected, streamLength) != 0) {
+        printf("FAIL header line: \"%.*s\"\n", (int)streamLength, stream);
+        failures++;
+    }
+
+    // The "H ", ':' and '\n' are charged on top of what the format produced
+    if (blackboxHeaderBudget != 100 - (int)(strlen("loopIteration,42") + 3)) {
+        printf("FAIL header budget: %d\n", blackboxHeaderBudget);
+        failures++;
+    }
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-n frames] [replay file]\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t benchFrames = DEFAULT_FRAMES;
+    const char *replayPath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            benchFrames = strtoul(argv[++i], NULL, 0);
+        } else if (argv[i][0] != '-' && !replayPath) {
+            replayPath = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (replayPath && !loadReplay(replayPath)) {
+        fprintf(stderr, "%s: no values to replay\n", replayPath);
+        return 2;
+    }
+
+    testHeaderLine();
+
+    printf("%-16s %-9s %9s %12s %10s\n", "encoder", "source", "frames", "bytes/frame", "ns/frame");
+
+    for (unsigned c = 0; c < CODEC_COUNT; c++) {
+        const codec_t *codec = &codecs[c];
+        frameStats_t stats;
+
+        testEdgeValues(codec);
+        testRandomValues(codec);
+
+        int32_t *frames = syntheticFlightDeltas(codec, benchFrames);
+        memset(&stats, 0, sizeof(stats));
+        roundTrip(codec, "synthetic", frames, benchFrames, &stats);
+        printStats(codec, "synthetic", &stats);
+        free(frames);
+
+        if (replayPath) {
+            uint32_t replayFrames;
+
+            frames = replayDeltas(codec, &replayFrames);
+            memset(&stats, 0, sizeof(stats));
+            roundTrip(codec, "replay", frames, replayFrames, &stats);
+            printStats(codec, "replay", &stats);
+            free(frames);
+        }
+    }
+
+    free(replayValues);
+
+    if (failures) {
+        printf("%d FAILED\n", failures);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}